@@ -0,0 +1,38 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto rank = mpi::comm("world")->rank();
+
+    auto number = mpi::comm("world")->allreduce(rank, mpi::sum);
+    std::cout << number << '\n';
+
+    number = mpi::comm("world")->iallreduce(rank, mpi::max)->get();
+    std::cout << number << '\n';
+
+    //a residual, an iteration count and an error bound are reduced in one collective
+    auto residual = 0.5 * rank;
+    auto iterations = 10 + rank;
+    auto error = 1e-3 / (rank + 1);
+    auto stats = mpi::comm("world")->allreduce(std::make_tuple(residual, iterations, error), std::make_tuple(mpi::sum, mpi::max, mpi::max));
+    std::cout << std::get<0>(stats) << ' ' << std::get<1>(stats) << ' ' << std::get<2>(stats) << '\n';
+
+    //block kernels combine whole buffers at once
+    auto values = std::vector<double>{rank - 2.5, 1.0 * rank};
+    auto peaks = mpi::comm("world")->allreduce(values, mpi::absmax);
+    std::cout << peaks[0] << ' ' << peaks[1] << '\n';
+
+    auto range = mpi::comm("world")->allreduce(std::make_pair(rank, rank), mpi::minmax);
+    std::cout << range.first << ' ' << range.second << '\n';
+
+    auto totals = mpi::comm("world")->allreduce(values, mpi::blockwise<true>([](const double *in, double *inout, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i)
+            inout[i] += in[i];
+    }));
+    std::cout << totals[0] << ' ' << totals[1] << '\n';
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    //rank, size and name are queried once and cached
+    auto world = mpi::comm("world");
+    std::cout << "rank " << world->rank() << " of " << world->size() << " in " << world->name() << '\n';
+
+    {
+        //a library should talk on its own duplicate, which is freed at the end of the scope
+        auto library = mpi::communicator{MPI_COMM_WORLD, true};
+        auto token = library.rank() == 0 ? 42 : 0;
+        library.source(0)->bcast(token);
+        std::cout << "rank " << library.rank() << " got " << token << " on the duplicate\n";
+    }
+
+    return 0;
+}
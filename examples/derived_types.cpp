@@ -0,0 +1,52 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+struct particle
+{
+    double position[3];
+    double velocity[3];
+    int id;
+    char kind;
+};
+//particles are sent member by member, so the padding is never transferred
+MPIWRAP_DESCRIBE(particle, &particle::position, &particle::velocity, &particle::id, &particle::kind)
+
+//without a description trivially copyable types are sent as bytes
+struct cell
+{
+    int x;
+    int y;
+};
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto world = mpi::comm("world");
+    auto rank = world->rank();
+    auto size = world->size();
+
+    //every process owns one particle and one cell
+    auto mine = particle{{1.0 * rank, 2.0, 3.0}, {0.5, 0.5, 0.5 * rank}, rank, static_cast<char>('a' + rank)};
+    auto particles = world->allgather(mine);
+    auto cells = world->allgather(cell{rank, -rank});
+
+    //the first process sends its particles to the last one
+    if (rank == 0)
+        world->dest(size - 1)->send(particles);
+    auto received = std::vector<particle>{};
+    if (rank == size - 1)
+        world->source(0)->recv(received);
+    else
+        received = particles;
+
+    auto is_correct = particles.size() == static_cast<size_t>(size) && received.size() == particles.size();
+    for (auto i = 0; i < size; ++i)
+    {
+        is_correct = is_correct && particles[i].id == i && particles[i].kind == 'a' + i && particles[i].velocity[2] == 0.5 * i;
+        is_correct = is_correct && received[i].position[0] == 1.0 * i && cells[i].x == i && cells[i].y == -i;
+    }
+    std::cout << "rank " << rank << " here, " << (is_correct ? "correct" : "wrong") << '\n';
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <mpiwrap/mpi.h>
+#include <iomanip>
+#include <iostream>
+
+//configure with -DCMAKE_BUILD_TYPE=Release, otherwise the wrapper itself is not optimized
+
+//measures the average time of an isend and its wait in microseconds, rank 1 receives with plain MPI, further ranks only join the barrier
+template <class Send>
+auto measure(int rank, int repetitions, Send send) -> double
+{
+    auto value = 0;
+    MPI_Barrier(MPI_COMM_WORLD);
+    auto start = MPI_Wtime();
+    for (auto i = 0; i < repetitions && rank <= 1; ++i)
+    {
+        if (rank == 0)
+            send(i);
+        else
+            MPI_Recv(&value, 1, MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
+    auto time = MPI_Wtime() - start;
+    return time / repetitions * 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto rank = mpi::comm("world")->rank();
+    constexpr auto repetitions = 200000;
+    constexpr auto tag = 7;
+
+    //run once without timing to warm up the connection
+    for (auto pass = 0; pass < 2; ++pass)
+    {
+        auto raw = measure(rank, repetitions, [](int i) {
+            auto _request = MPI_Request{};
+            MPI_Isend(&i, 1, MPI_INT, 1, tag, MPI_COMM_WORLD, &_request);
+            MPI_Wait(&_request, MPI_STATUS_IGNORE);
+        });
+        auto world = mpi::comm("world");
+        auto chained = measure(rank, repetitions, [&world](int i) {
+            world->dest(1, tag)->isend(i)->wait();
+        });
+        auto dest = world->dest(1, tag);
+        auto handle = measure(rank, repetitions, [&dest](int i) {
+            dest.isend(i)->wait();
+        });
+
+        if (rank == 0 && pass == 1)
+        {
+            std::cout << std::setw(22) << "raw MPI_Isend [us]" << std::setw(22) << "dest()->isend [us]" << std::setw(22) << "handle.isend [us]" << '\n';
+            std::cout << std::fixed << std::setprecision(3) << std::setw(22) << raw << std::setw(22) << chained << std::setw(22) << handle << '\n';
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto world = mpi::comm("world");
+    auto rank = world->rank();
+    auto size = world->size();
+
+    //every collective on world without a hierarchy argument runs node-aware from now on
+    world->set_hierarchy(mpi::hierarchy::node_aware);
+
+    //sum of all ranks
+    auto sum = std::vector<int>{};
+    world->allreduce(std::vector<int>{rank, 1}, sum, mpi::sum);
+    //the world ranks in rank order
+    auto ranks = std::vector<int>{};
+    world->allgather(rank, ranks);
+    //the last rank sends to everyone
+    auto message = std::vector<double>(3, (rank == size - 1) ? 4.2 : 0.0);
+    world->source(size - 1)->bcast(message);
+    auto greeting = std::string{(rank == size - 1) ? "hello" : ""};
+    world->source(size - 1)->bcast(greeting);
+    //the maximum is collected by the last rank, this call explicitly runs flat
+    auto maximum = int{};
+    world->dest(size - 1)->reduce(rank, maximum, mpi::max, mpi::hierarchy::flat);
+    auto total = int{};
+    world->dest(size - 1)->reduce(rank, total, mpi::sum);
+
+    auto is_correct = sum[0] == size * (size - 1) / 2 && sum[1] == size && message[2] == 4.2 && greeting == "hello";
+    for (auto i = 0; i < size; ++i)
+        is_correct = is_correct && ranks[i] == i;
+    if (rank == size - 1)
+        is_correct = is_correct && maximum == size - 1 && total == sum[0];
+    std::cout << "rank " << rank << " here, " << (is_correct ? "correct" : "wrong") << '\n';
+
+    return 0;
+}
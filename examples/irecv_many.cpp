@@ -0,0 +1,36 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto rank = mpi::comm("world")->rank();
+    auto size = mpi::comm("world")->size();
+
+    //post all receives up front, none of them blocks until its message arrives
+    auto requests = std::vector<std::unique_ptr<mpi::irecv_reply<std::vector<int>>>>{};
+    for (auto source = 0; source < size; ++source)
+        if (source != rank)
+            requests.emplace_back(mpi::comm("world")->source(source)->irecv<std::vector<int>>());
+    auto message_request = mpi::comm("world")->source((rank + size - 1) % size)->irecv<std::string>();
+
+    //every rank sends a differently sized vector to every other rank
+    auto sends = std::vector<std::unique_ptr<mpi::isend_request<std::vector<int>>>>{};
+    for (auto dest = 0; dest < size; ++dest)
+        if (dest != rank)
+            sends.emplace_back(mpi::comm("world")->dest(dest)->isend(std::vector<int>(rank + 1, rank)));
+    auto message = std::string(rank + 1, 'a' + rank % 26);
+    mpi::comm("world")->dest((rank + 1) % size)->send(message);
+
+    for (auto &&request : sends)
+        request->wait();
+    for (auto &&request : requests)
+    {
+        auto numbers = request->get();
+        std::cout << "Rank " << rank << " got " << numbers.size() << " numbers from rank " << numbers.front() << '\n';
+    }
+    std::cout << "Rank " << rank << " got message: " << message_request->get() << '\n';
+
+    return 0;
+}
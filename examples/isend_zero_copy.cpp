@@ -0,0 +1,51 @@
+#include <mpiwrap/mpi.h>
+#include <array>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto rank = mpi::comm("world")->rank();
+    if (rank == 0)
+    {
+        //the vector is moved into the request, no copy is made
+        auto field = std::vector<double>(1 << 20, 1.0);
+        auto moved_request = mpi::comm("world")->dest(1)->isend(std::move(field));
+
+        //the buffer is only borrowed, it has to outlive the request
+        auto message = std::string{"Hello, there\n"};
+        auto borrowed_request = mpi::comm("world")->dest(1)->issend(mpi::borrow(message));
+
+        moved_request->wait();
+        borrowed_request->wait();
+
+        //ready mode needs the matching receive to be posted already
+        auto numbers = std::array<int, 3>{1, 2, 3};
+        mpi::comm("world")->barrier();
+        auto ready_request = mpi::comm("world")->dest(1)->irsend(numbers);
+        ready_request->wait();
+    }
+    else if (rank == 1)
+    {
+        auto field = mpi::comm("world")->source(0)->irecv<std::vector<double>>()->get();
+        std::cout << "Field: " << field.size() << " values\n";
+
+        auto message = mpi::comm("world")->source(0)->irecv<std::string>()->get();
+        std::cout << "Message: " << message;
+
+        //a fixed-size bucket is posted right away, vectors would wait for their message to be probed
+        auto numbers = std::array<int, 3>{};
+        auto numbers_request = mpi::comm("world")->source(0)->irecv(numbers);
+        mpi::comm("world")->barrier();
+        numbers_request->wait();
+        std::cout << "Numbers: ";
+        for (auto &&number : numbers)
+            std::cout << number << ' ';
+        std::cout << '\n';
+    }
+    else
+        mpi::comm("world")->barrier();
+
+    return 0;
+}
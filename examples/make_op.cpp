@@ -1,4 +1,5 @@
 #include <mpiwrap/mpi.h>
+#include <algorithm>
 #include <iostream>
 #include <functional>
 
@@ -69,6 +70,17 @@ int main(int argc, char **argv)
         std::cout << '\n';
     }
 
+    //capturing lambda, the limit travels with the operation
+    auto limit = 6;
+    auto capture = [limit](auto a, auto b) { return std::min(a + b, limit); };
+    numbers = mpi::comm("world")->dest(0)->reduce(std::vector<int>{rank, 5 - rank}, capture);
+    if (rank == 0)
+    {
+        for (auto &&number : numbers)
+            std::cout << number << ' ';
+        std::cout << '\n';
+    }
+
     //builtin
     auto builtin = mpi::sum;
     numbers = mpi::comm("world")->dest(0)->reduce(std::vector<int>{rank, 5 - rank}, builtin);
@@ -0,0 +1,34 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto rank = mpi::comm("world")->rank();
+    auto size = mpi::comm("world")->size();
+    auto right = (rank + 1) % size;
+    auto left = (rank + size - 1) % size;
+
+    //the buffers are bound once, the requests only get restarted
+    auto outgoing = std::vector<double>(4, rank);
+    auto incoming = std::vector<double>(4);
+    auto send_request = mpi::comm("world")->dest(right)->send_init(outgoing);
+    auto recv_request = mpi::comm("world")->source(left)->recv_init(incoming);
+
+    for (auto iteration = 0; iteration < 3; ++iteration)
+    {
+        mpi::startall(recv_request, send_request);
+        mpi::waitall(recv_request, send_request);
+
+        for (auto &&value : outgoing)
+            value = incoming.front() + 1;
+    }
+
+    std::cout << "rank " << rank << " here, with: ";
+    for (auto &&value : incoming)
+        std::cout << value << ' ';
+    std::cout << '\n';
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto world = mpi::comm("world");
+    auto rank = world->rank();
+    auto size = world->size();
+
+    //the plans bind buffers, operations and sizes once
+    auto residual = double{};
+    auto max_residual = double{};
+    auto fluxes = std::vector<double>(3);
+    auto total_fluxes = std::vector<double>{};
+    auto step = 0;
+    auto ranks = std::vector<int>{};
+    auto outgoing = std::vector<int>(size, rank);
+    auto incoming = std::vector<int>{};
+
+    auto residual_plan = world->allreduce_init(residual, max_residual, mpi::max);
+    auto fluxes_plan = world->allreduce_init(fluxes, total_fluxes, mpi::sum);
+    auto step_plan = world->source(0)->bcast_init(step);
+    auto ranks_plan = world->allgather_init(rank, ranks);
+    auto exchange_plan = world->alltoall_init(outgoing, incoming, 1);
+
+    for (auto iteration = 0; iteration < 5; ++iteration)
+    {
+        residual = 1.0 / (rank + iteration + 1);
+        for (auto i = size_t{0}; i < fluxes.size(); ++i)
+            fluxes[i] = (i + 1.0) * rank;
+        if (rank == 0)
+            step = iteration;
+
+        mpi::startall(residual_plan, fluxes_plan, step_plan, ranks_plan, exchange_plan);
+        mpi::waitall(residual_plan, fluxes_plan, step_plan, ranks_plan, exchange_plan);
+    }
+
+    std::cout << "rank " << rank << " here, step " << step << ", max residual " << max_residual << ", fluxes ";
+    for (auto &&flux : total_fluxes)
+        std::cout << flux << ' ';
+    std::cout << ", ranks ";
+    for (auto &&value : ranks)
+        std::cout << value << ' ';
+    std::cout << ", exchanged ";
+    for (auto &&value : incoming)
+        std::cout << value << ' ';
+    std::cout << '\n';
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto world = mpi::comm("world");
+    auto rank = world->rank();
+    auto size = world->size();
+
+    //every module adds its own small reductions, they are only sent on flush
+    auto batch = world->reduction_batch();
+    auto mass = batch->allreduce(1.0 + rank, mpi::sum);
+    auto energy = batch->allreduce(0.5 * rank, mpi::sum);
+    auto cells = batch->allreduce(100L, mpi::sum);
+    auto max_velocity = batch->allreduce(2.0 * rank, mpi::max);
+    auto momentum = batch->allreduce(std::vector<double>{1.0, -1.0, 0.5}, mpi::sum);
+
+    //one allreduce for the double sums, one for the long sum and one for the double maximum
+    batch->flush();
+
+    auto is_correct = mass.get() == size * (size + 1) / 2.0 && energy.get() == size * (size - 1) / 4.0;
+    is_correct = is_correct && cells.get() == 100L * size && max_velocity.get() == 2.0 * (size - 1);
+    is_correct = is_correct && momentum.get() == std::vector<double>{1.0 * size, -1.0 * size, 0.5 * size};
+    std::cout << "rank " << rank << " here, " << (is_correct ? "correct" : "wrong") << '\n';
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto rank = mpi::comm("world")->rank();
+    auto size = mpi::comm("world")->size();
+
+    //every rank sends a number to every other rank
+    auto numbers = std::vector<int>(size);
+    auto sends = std::vector<std::unique_ptr<mpi::isend_request<int>>>{};
+    auto recvs = std::vector<std::unique_ptr<mpi::irecv_request<int>>>{};
+    auto requests = mpi::request_set{};
+    requests.reserve(2 * size);
+    for (auto other = 0; other < size; ++other)
+    {
+        recvs.push_back(mpi::comm("world")->source(other)->irecv(numbers[other]));
+        requests.add(recvs.back());
+    }
+    for (auto other = 0; other < size; ++other)
+    {
+        sends.push_back(mpi::comm("world")->dest(other)->isend(rank * 10));
+        requests.add(sends.back());
+    }
+
+    //poll until every request is finished
+    auto finished = size_t{0};
+    while (finished < requests.size())
+        finished += requests.testsome().size();
+
+    std::cout << "rank " << rank << " here, with: ";
+    for (auto &&number : numbers)
+        std::cout << number << ' ';
+    std::cout << '\n';
+
+    return 0;
+}
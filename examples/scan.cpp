@@ -0,0 +1,32 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto world = mpi::comm("world");
+    auto rank = world->rank();
+    auto size = world->size();
+
+    //every process writes rank + 1 records into a shared file, exscan gives each one its offset
+    auto records = rank + 1;
+    auto offset = world->exscan(records, mpi::sum);
+    auto written = world->scan(records, mpi::sum);
+
+    //running maximum with a custom operation
+    auto running_max = std::vector<int>{};
+    auto request = world->iscan(std::vector<int>{rank % 2, rank}, running_max, [](int a, int b) { return a > b ? a : b; });
+
+    //every process holds a histogram over all bins and keeps the global counts of two of them
+    auto histogram = std::vector<long>(2 * size, 1);
+    auto bins = world->reduce_scatter_block(histogram, mpi::sum);
+    request->wait();
+
+    auto is_correct = offset == rank * (rank + 1) / 2 && written == offset + records;
+    is_correct = is_correct && running_max == std::vector<int>{rank > 0 ? 1 : 0, rank};
+    is_correct = is_correct && bins == std::vector<long>(2, size);
+    std::cout << "rank " << rank << " here, " << (is_correct ? "correct" : "wrong") << '\n';
+
+    return 0;
+}
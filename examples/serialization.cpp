@@ -0,0 +1,51 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto world = mpi::comm("world");
+    auto rank = world->rank();
+    auto size = world->size();
+    auto left = (rank + size - 1) % size;
+    auto right = (rank + 1) % size;
+
+    //every container of non-trivial elements travels as a single packed message
+    auto words = std::vector<std::string>{"rank", std::to_string(rank), "", "says hello"};
+    auto counts = std::map<std::string, int>{{"rank", rank}, {"size", size}};
+    auto triangle = std::vector<std::vector<int>>(rank + 1);
+    for (auto i = 0; i <= rank; ++i)
+        triangle[i] = std::vector<int>(i + 1, rank);
+
+    //blocking receive around the ring
+    auto incoming_words = std::vector<std::string>{};
+    auto sent_words = world->dest(right)->isend(words);
+    world->source(left)->recv(incoming_words);
+    sent_words->wait();
+
+    //nonblocking send and receive
+    auto incoming_counts = std::map<std::string, int>{};
+    auto incoming_triangle = std::vector<std::vector<int>>{};
+    auto received = world->source(left)->irecv(incoming_counts);
+    auto received_triangle = world->source(left)->irecv(incoming_triangle);
+    auto sent = world->dest(right)->isend(counts);
+    auto sent_triangle = world->dest(right)->isend(triangle);
+    mpi::waitall(received, received_triangle, sent, sent_triangle);
+
+    //the first process broadcasts its lookup table
+    auto table = std::unordered_map<int, std::string>{};
+    if (rank == 0)
+        table = {{1, "one"}, {2, "two"}, {3, "three"}};
+    world->source(0)->bcast(table);
+
+    auto is_correct = incoming_words == std::vector<std::string>{"rank", std::to_string(left), "", "says hello"};
+    is_correct = is_correct && incoming_counts == std::map<std::string, int>{{"rank", left}, {"size", size}};
+    is_correct = is_correct && incoming_triangle.size() == static_cast<size_t>(left + 1);
+    for (auto i = 0; is_correct && i <= left; ++i)
+        is_correct = incoming_triangle[i] == std::vector<int>(i + 1, left);
+    is_correct = is_correct && table.size() == 3 && table[3] == "three";
+    std::cout << "rank " << rank << " here, " << (is_correct ? "correct" : "wrong") << '\n';
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto world = mpi::comm("world");
+    auto rank = world->rank();
+
+    //a lookup table which exists only once per node
+    auto table = std::vector<double>{};
+    if (rank == 0)
+        for (auto i = 0; i < 1000; ++i)
+            table.push_back(i * 0.5);
+    auto shared_table = world->source(0)->share(table);
+
+    //a scratch array which the processes of a node fill together
+    auto scratch = world->allocate_shared<int>(shared_table.local_size());
+    scratch[scratch.local_rank()] = rank;
+    scratch.sync();
+
+    auto sum = 0;
+    for (auto &&value : scratch)
+        sum += value;
+    std::cout << "rank " << rank << " here, local rank " << scratch.local_rank() << " of " << scratch.local_size()
+              << ", table[999] = " << shared_table[999] << ", sum of the node ranks " << sum << '\n';
+
+    return 0;
+}
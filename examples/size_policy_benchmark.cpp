@@ -0,0 +1,47 @@
+#include <mpiwrap/mpi.h>
+#include <iomanip>
+#include <iostream>
+
+//measures the average latency of a vector allreduce in microseconds
+auto measure(mpi::size_policy policy, size_t count, int repetitions) -> double
+{
+    mpi::set_size_policy(policy);
+    auto values = std::vector<double>(count, 1.0);
+    auto bucket = std::vector<double>(count);
+
+    //warm up
+    for (auto i = 0; i < 10; ++i)
+        mpi::comm("world")->allreduce(values, bucket, mpi::sum);
+
+    mpi::comm("world")->barrier();
+    auto start = MPI_Wtime();
+    for (auto i = 0; i < repetitions; ++i)
+        mpi::comm("world")->allreduce(values, bucket, mpi::sum);
+    auto time = MPI_Wtime() - start;
+    //the slowest rank decides
+    return mpi::comm("world")->allreduce(std::vector<double>{time}, mpi::max).front() / repetitions * 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto rank = mpi::comm("world")->rank();
+    constexpr auto repetitions = 10000;
+
+    if (rank == 0)
+        std::cout << std::setw(8) << "bytes" << std::setw(14) << "checked [us]" << std::setw(14) << "trusted [us]" << std::setw(10) << "saved" << '\n';
+    for (auto bytes = size_t{8}; bytes <= 1024; bytes *= 2)
+    {
+        auto count = bytes / sizeof(double);
+        auto checked = measure(mpi::size_policy::checked, count, repetitions);
+        auto trusted = measure(mpi::size_policy::trusted, count, repetitions);
+        if (rank == 0)
+            std::cout << std::setw(8) << bytes
+                      << std::setw(14) << std::fixed << std::setprecision(2) << checked
+                      << std::setw(14) << trusted
+                      << std::setw(9) << std::setprecision(0) << 100.0 * (checked - trusted) / checked << "%\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto world = mpi::comm("world");
+    auto rank = world->rank();
+
+    //processes sharing memory, usually one node
+    auto node = world->split_type();
+    //even and odd ranks
+    auto parity = world->split(rank % 2);
+    //only the first two ranks
+    auto pair = world->create(std::vector<int>{0, 1});
+    //a nonblocking duplicate
+    auto duplicate_request = world->idup();
+
+    auto duplicate = duplicate_request->get();
+    std::cout << "rank " << rank << " here, node rank " << node->rank() << " of " << node->size()
+              << ", parity rank " << parity->rank() << " of " << parity->size()
+              << ", duplicate rank " << duplicate->rank();
+    if (pair)
+        std::cout << ", pair rank " << pair->rank();
+    std::cout << '\n';
+
+    //the ranks in the parity communicator exchange their world ranks
+    auto ranks = parity->allgather(rank);
+    if (parity->rank() == 0)
+    {
+        std::cout << "parity " << rank % 2 << " has: ";
+        for (auto &&value : ranks)
+            std::cout << value << ' ';
+        std::cout << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    //periodic in x, open in y, MPI picks the grid shape and may renumber the processes
+    auto grid = mpi::comm("world")->cart_create({0, 0}, {true, false});
+    auto rank = grid->rank();
+    auto x = grid->shift(0);
+    auto y = grid->shift(1);
+
+    //one boundary value per neighbor, in the order -x, +x, -y, +y
+    auto boundary = std::vector<double>{rank + 0.1, rank + 0.2, rank + 0.3, rank + 0.4};
+    auto halo = std::vector<double>(4, -1.0);
+    auto exchange = grid->ineighbor_alltoall(boundary, halo, 1);
+    //every process also learns the ranks of its neighbors, missing ones stay at -1
+    auto neighbors = std::vector<int>(4, -1);
+    grid->neighbor_allgather(rank, neighbors);
+    exchange->wait();
+
+    //the -x halo is the +x boundary of the left neighbor and so on, only checked where the two sides differ
+    auto is_correct = true;
+    if (x.first != x.second)
+        is_correct = is_correct && halo[0] == x.first + 0.2 && halo[1] == x.second + 0.1;
+    is_correct = is_correct && (y.first == MPI_PROC_NULL ? halo[2] == -1.0 && neighbors[2] == -1 : halo[2] == y.first + 0.4 && neighbors[2] == y.first);
+    is_correct = is_correct && (y.second == MPI_PROC_NULL ? halo[3] == -1.0 && neighbors[3] == -1 : halo[3] == y.second + 0.3 && neighbors[3] == y.second);
+    auto coords = grid->coords();
+    std::cout << "rank " << rank << " at (" << coords[0] << ", " << coords[1] << ") here, " << (is_correct ? "correct" : "wrong") << '\n';
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto world = mpi::comm("world");
+    auto rank = world->rank();
+    auto size = world->size();
+
+    //every process owns rank + 1 particles, the counts are exchanged automatically
+    auto particles = std::vector<int>(rank + 1, rank);
+    auto everyone = world->allgatherv(particles);
+    auto on_root = world->dest(0)->gatherv(particles);
+
+    //the counts are known everywhere, so no exchange is needed
+    auto counts = std::vector<size_t>(size);
+    for (auto p = 0; p < size; ++p)
+        counts[p] = p + 1;
+    auto again = std::vector<int>{};
+    auto gathered = world->iallgatherv(particles, again, counts);
+
+    //the root hands every process its particles back
+    auto returned = world->source(0)->scatterv(everyone, counts);
+
+    //every process sends p + 1 values to process p and receives rank + 1 values from everyone
+    auto outgoing = std::vector<int>{};
+    for (auto p = 0; p < size; ++p)
+        outgoing.insert(outgoing.end(), p + 1, rank * 100 + p);
+    auto incoming = world->alltoallv(outgoing, counts);
+    gathered->wait();
+
+    auto is_correct = everyone.size() == static_cast<size_t>(size * (size + 1) / 2) && again == everyone && returned == particles;
+    is_correct = is_correct && (rank != 0 || on_root == everyone);
+    is_correct = is_correct && incoming.size() == static_cast<size_t>(size * (rank + 1));
+    for (size_t i = 0; i < incoming.size(); ++i)
+        is_correct = is_correct && incoming[i] == static_cast<int>(i / (rank + 1)) * 100 + rank;
+    std::cout << "rank " << rank << " here, " << (is_correct ? "correct" : "wrong") << '\n';
+
+    return 0;
+}
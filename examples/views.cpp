@@ -0,0 +1,50 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto world = mpi::comm("world");
+    auto rank = world->rank();
+    auto size = world->size();
+    auto left = (rank + size - 1) % size;
+    auto right = (rank + 1) % size;
+
+    //a 4x6 grid per process with one ghost column on each side
+    auto rows = 4;
+    auto columns = 6;
+    auto grid = std::vector<double>(rows * columns, rank);
+    //the last inner column goes to the right neighbour, which stores it in its left ghost column
+    world->dest(right)->source(left)->sendrecv(mpi::column(grid, columns, columns - 2), mpi::column(grid, columns, 0));
+    world->dest(left)->source(right)->sendrecv(mpi::column(grid, columns, 1), mpi::column(grid, columns, columns - 1));
+
+    //a 2x2x2 block from the middle of a 4x4x4 cube
+    auto cube = std::vector<int>(64);
+    for (auto i = 0; i < 64; ++i)
+        cube[i] = rank * 100 + i;
+    auto block = mpi::subarray(cube, {4, 4, 4}, {2, 2, 2}, {1, 1, 1});
+    auto blocks = std::vector<int>{};
+    world->allgather(block, blocks);
+    //the first process broadcasts its block into the corner of every cube
+    world->source(0)->bcast(mpi::subarray(cube, {4, 4, 4}, {2, 2, 2}, {0, 0, 0}));
+
+    //every third element travels around the ring
+    auto values = std::vector<int>(9, rank);
+    auto incoming = std::vector<int>(9, -1);
+    auto sent = world->dest(right)->isend(mpi::strided(values, 3, 1, 3));
+    auto received = world->source(left)->irecv(mpi::strided(incoming, 3, 1, 3));
+    mpi::waitall(sent, received);
+
+    auto is_correct = blocks.size() == static_cast<size_t>(8 * size);
+    for (auto r = 0; r < rows; ++r)
+        is_correct = is_correct && grid[r * columns] == left && grid[r * columns + columns - 1] == right && grid[r * columns + 1] == rank;
+    for (auto p = 0; p < size; ++p)
+        is_correct = is_correct && blocks[8 * p] == p * 100 + 21 && blocks[8 * p + 7] == p * 100 + 42;
+    is_correct = is_correct && cube[0] == 0 && cube[21] == 21 && cube[42] == rank * 100 + 42;
+    for (auto i = 0; i < 9; ++i)
+        is_correct = is_correct && incoming[i] == ((i % 3 == 0) ? left : -1);
+    std::cout << "rank " << rank << " here, " << (is_correct ? "correct" : "wrong") << '\n';
+
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <mpiwrap/mpi.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    mpi::mpi init{argc, argv};
+
+    auto world = mpi::comm("world");
+    auto rank = world->rank();
+    auto size = world->size();
+
+    //every process has one slot per process, plus a counter
+    auto window = world->allocate_window<int>(size + 1);
+    std::fill(window.data(), window.data() + window.size(), 0);
+
+    //everyone writes its rank into its slot on every process
+    window.fence();
+    for (auto target = 0; target < size; ++target)
+        window.put(rank, target, rank);
+    window.fence();
+
+    //everyone adds to the counter of process 0 and draws a ticket from it
+    auto ticket = int{};
+    window.lock(0);
+    window.fetch_and_op(1, ticket, 0, size, mpi::sum);
+    window.unlock(0);
+    world->barrier();
+
+    //the next process reads the slots of this one, while it overwrites its own slot remotely
+    auto next = (rank + 1) % size;
+    auto slots = std::vector<int>(size);
+    window.lock_all();
+    auto read = window.rget(slots, next, 0);
+    mpi::waitall(read);
+    auto previous = int{};
+    window.compare_and_swap(-1, rank, previous, rank, rank);
+    window.unlock_all();
+    world->barrier();
+
+    auto is_correct = previous == rank && window[rank] == -1;
+    for (auto i = 0; i < size; ++i)
+        is_correct = is_correct && (slots[i] == i || i == next);
+    if (rank == 0)
+        is_correct = is_correct && window[size] == size;
+    std::cout << "rank " << rank << " here, ticket " << ticket << ", " << (is_correct ? "correct" : "wrong") << '\n';
+
+    return 0;
+}
@@ -58,6 +58,33 @@ struct minloc
 struct no_op
 {
 };
+//value with the largest magnitude, its sign is kept and ties go to the larger value
+struct absmax_kernel
+{
+    template <class T>
+    auto operator()(const T *in, T *inout, size_t n) const -> void
+    {
+        for (auto i = size_t{}; i < n; ++i)
+        {
+            auto a = (in[i] < T{}) ? -in[i] : in[i];
+            auto b = (inout[i] < T{}) ? -inout[i] : inout[i];
+            inout[i] = (b < a || (a == b && inout[i] < in[i])) ? in[i] : inout[i];
+        }
+    }
+};
+//minimum in first and maximum in second, so both bounds take one reduction
+struct minmax_kernel
+{
+    template <class T>
+    auto operator()(const std::pair<T, T> *in, std::pair<T, T> *inout, size_t n) const -> void
+    {
+        for (auto i = size_t{}; i < n; ++i)
+        {
+            inout[i].first = (in[i].first < inout[i].first) ? in[i].first : inout[i].first;
+            inout[i].second = (inout[i].second < in[i].second) ? in[i].second : inout[i].second;
+        }
+    }
+};
 //replace --> f(a,b) = b
 struct replace
 {
@@ -78,8 +105,125 @@ constexpr auto bxor = impl::bxor{};
 constexpr auto maxloc = impl::maxloc{};
 constexpr auto minloc = impl::minloc{};
 constexpr auto no_op = impl::no_op{};
+constexpr auto absmax = blockwise_op<impl::absmax_kernel, true>{};
+constexpr auto minmax = blockwise_op<impl::minmax_kernel, true>{};
 constexpr auto replace = impl::replace{};
 
+namespace impl
+{
+//elementwise forms of the builtin operations, used when they are combined in a tuple
+//maximum
+template <>
+struct op_function<max>
+{
+    static constexpr bool commutes = true;
+    template <class T>
+    static auto apply(max &, const T &a, const T &b) -> T
+    {
+        return (a < b) ? b : a;
+    }
+};
+//minimum
+template <>
+struct op_function<min>
+{
+    static constexpr bool commutes = true;
+    template <class T>
+    static auto apply(min &, const T &a, const T &b) -> T
+    {
+        return (b < a) ? b : a;
+    }
+};
+//sum
+template <>
+struct op_function<sum>
+{
+    static constexpr bool commutes = true;
+    template <class T>
+    static auto apply(sum &, const T &a, const T &b) -> T
+    {
+        return a + b;
+    }
+};
+//product
+template <>
+struct op_function<prod>
+{
+    static constexpr bool commutes = true;
+    template <class T>
+    static auto apply(prod &, const T &a, const T &b) -> T
+    {
+        return a * b;
+    }
+};
+//logical and
+template <>
+struct op_function<land>
+{
+    static constexpr bool commutes = true;
+    template <class T>
+    static auto apply(land &, const T &a, const T &b) -> T
+    {
+        return a && b;
+    }
+};
+//bitwise and
+template <>
+struct op_function<band>
+{
+    static constexpr bool commutes = true;
+    template <class T>
+    static auto apply(band &, const T &a, const T &b) -> T
+    {
+        return a & b;
+    }
+};
+//logical or
+template <>
+struct op_function<lor>
+{
+    static constexpr bool commutes = true;
+    template <class T>
+    static auto apply(lor &, const T &a, const T &b) -> T
+    {
+        return a || b;
+    }
+};
+//bitwise or
+template <>
+struct op_function<bor>
+{
+    static constexpr bool commutes = true;
+    template <class T>
+    static auto apply(bor &, const T &a, const T &b) -> T
+    {
+        return a | b;
+    }
+};
+//logical xor
+template <>
+struct op_function<lxor>
+{
+    static constexpr bool commutes = true;
+    template <class T>
+    static auto apply(lxor &, const T &a, const T &b) -> T
+    {
+        return !a != !b;
+    }
+};
+//bitwise xor
+template <>
+struct op_function<bxor>
+{
+    static constexpr bool commutes = true;
+    template <class T>
+    static auto apply(bxor &, const T &a, const T &b) -> T
+    {
+        return a ^ b;
+    }
+};
+} // namespace impl
+
 //maximum
 template <class T>
 class op_proxy<T, impl::max> : public op
@@ -87,7 +231,7 @@ class op_proxy<T, impl::max> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_MAX, _commute) {}
+    op_proxy(const bool) : op(MPI_MAX, true) {}
 };
 //minimum
 template <class T>
@@ -96,7 +240,7 @@ class op_proxy<T, impl::min> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_MIN, _commute) {}
+    op_proxy(const bool) : op(MPI_MIN, true) {}
 };
 //sum
 template <class T>
@@ -105,7 +249,7 @@ class op_proxy<T, impl::sum> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_SUM, _commute) {}
+    op_proxy(const bool) : op(MPI_SUM, true) {}
 };
 //std::plus overload for sum
 template <class T>
@@ -120,7 +264,7 @@ class op_proxy<T, impl::prod> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_PROD, _commute) {}
+    op_proxy(const bool) : op(MPI_PROD, true) {}
 };
 //std::multiplies overload for product
 template <class T>
@@ -135,7 +279,7 @@ class op_proxy<T, impl::land> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_LAND, _commute) {}
+    op_proxy(const bool) : op(MPI_LAND, true) {}
 };
 //std::logical_and overload for logical and
 template <class T>
@@ -150,7 +294,7 @@ class op_proxy<T, impl::band> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_BAND, _commute) {}
+    op_proxy(const bool) : op(MPI_BAND, true) {}
 };
 //std::bit_and overload for bitwise and
 template <class T>
@@ -165,7 +309,7 @@ class op_proxy<T, impl::lor> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_LOR, _commute) {}
+    op_proxy(const bool) : op(MPI_LOR, true) {}
 };
 //std::logical_or overload for logical or
 template <class T>
@@ -180,7 +324,7 @@ class op_proxy<T, impl::bor> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_BOR, _commute) {}
+    op_proxy(const bool) : op(MPI_BOR, true) {}
 };
 //std::bit_or overload for bitwise or
 template <class T>
@@ -195,7 +339,7 @@ class op_proxy<T, impl::lxor> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_LXOR, _commute) {}
+    op_proxy(const bool) : op(MPI_LXOR, true) {}
 };
 //bitwise xor
 template <class T>
@@ -204,7 +348,7 @@ class op_proxy<T, impl::bxor> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_BXOR, _commute) {}
+    op_proxy(const bool) : op(MPI_BXOR, true) {}
 };
 //std::bit_xor overload for bitwise xor
 template <class T>
@@ -219,7 +363,7 @@ class op_proxy<T, impl::maxloc> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_MAXLOC, _commute) {}
+    op_proxy(const bool) : op(MPI_MAXLOC, true) {}
 };
 //minimum value and location
 template <class T>
@@ -228,7 +372,7 @@ class op_proxy<T, impl::minloc> : public op
     using op::op;
 
 public:
-    op_proxy(const bool _commute) : op(MPI_MINLOC, _commute) {}
+    op_proxy(const bool) : op(MPI_MINLOC, true) {}
 };
 //do nothing
 template <class T>
@@ -1,7 +1,13 @@
 #pragma once
 #include <mpi.h>
+#include <limits>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 //helper macro
@@ -10,14 +16,35 @@
 #else
 #define paranoidly_assert(condition) ((void)0)
 #endif
+//lists the members of a struct, so it is sent as an MPI struct type, use it at global scope:
+//MPIWRAP_DESCRIBE(particle, &particle::position, &particle::id)
+#define MPIWRAP_DESCRIBE(type, ...)                                         \
+    namespace mpi                                                           \
+    {                                                                       \
+    template <>                                                             \
+    struct describe<type>                                                   \
+    {                                                                       \
+        static auto members() { return std::make_tuple(__VA_ARGS__); }      \
+    };                                                                      \
+    }
 
 namespace mpi
 {
 #pragma region type wrapper
-template <class>
+//member list of a struct, see MPIWRAP_DESCRIBE
+template <class T>
+struct describe;
+namespace impl
+{
+//described structs become struct types, other trivially copyable types are sent as bytes,
+//both are built and committed once per type
+template <class T>
+auto derived_type() -> MPI_Datatype;
+} // namespace impl
+template <class T>
 struct type_wrapper
 {
-    operator MPI_Datatype() const { return MPI_DATATYPE_NULL; }
+    operator MPI_Datatype() const { return impl::derived_type<T>(); }
 };
 template <>
 struct type_wrapper<bool>
@@ -101,6 +128,208 @@ auto initialized() -> bool;
 auto finalized() -> bool;
 auto processor_name() -> std::string;
 #pragma endregion
+#pragma region size policy
+//collectives of vectors and strings need the same size on every rank,
+//the policy decides whether this is checked against the root with an extra broadcast,
+//it has to be the same on every rank of a communicator
+enum class size_policy
+{
+    trusted, //never check, no extra traffic
+    checked, //always check, meant for debugging
+};
+auto set_size_policy(size_policy _policy) -> void;
+auto get_size_policy() -> size_policy;
+namespace impl
+{
+auto negotiate_size() -> bool;
+//aborts if the size differs from the one of the root
+auto check_size(MPI_Comm _comm, int _root, size_t _size) -> void;
+} // namespace impl
+#pragma endregion
+#pragma region large counts
+//MPI-4 takes MPI_Count directly through the _c variant of every call
+#if MPI_VERSION >= 4
+#define MPIWRAP_LARGE(function) function##_c
+#else
+#define MPIWRAP_LARGE(function) function
+#endif
+namespace impl
+{
+#if MPI_VERSION >= 4
+using count_type = MPI_Count;
+#else
+using count_type = int;
+#endif
+//largest count a single call takes, reductions are split into chunks of this size
+constexpr auto max_count = static_cast<size_t>(std::numeric_limits<count_type>::max());
+//count of a call which cannot be split, throws std::length_error beyond max_count
+auto checked_count(size_t _count) -> count_type;
+//count and datatype of a buffer with any number of elements,
+//before MPI-4 a buffer beyond max_count becomes one element of a contiguous-blocks type
+class large_count
+{
+private:
+    count_type _count;
+    MPI_Datatype _type;
+    bool is_derived = false;
+
+public:
+    large_count(size_t _count, MPI_Datatype _type);
+    large_count(large_count &&_other);
+    large_count(const large_count &) = delete;
+    auto operator=(const large_count &) -> large_count & = delete;
+    ~large_count();
+
+    auto count() const -> count_type;
+    auto type() const -> MPI_Datatype;
+};
+//number of received elements, which may not fit into an int
+auto get_count(const MPI_Status *_status, MPI_Datatype _type) -> size_t;
+} // namespace impl
+#pragma endregion
+#pragma region variable counts
+namespace impl
+{
+#if MPI_VERSION >= 4
+using displacement_type = MPI_Aint;
+#else
+using displacement_type = int;
+#endif
+//per-process counts of a v-collective and the displacements which pack them without gaps
+struct v_counts
+{
+    std::vector<count_type> _counts;
+    std::vector<displacement_type> _displacements;
+    size_t _total = 0;
+};
+auto make_counts(const std::vector<size_t> &_counts) -> v_counts;
+//one small exchange of the counts, for gather only the root learns them
+auto allgather_counts(MPI_Comm _comm, size_t _count) -> v_counts;
+auto alltoall_counts(MPI_Comm _comm, const std::vector<size_t> &_counts) -> v_counts;
+auto gather_counts(int _dest, MPI_Comm _comm, size_t _count) -> v_counts;
+auto scatter_count(int _source, MPI_Comm _comm, const std::vector<size_t> &_counts) -> size_t;
+} // namespace impl
+#pragma endregion
+#pragma region borrowed buffer
+//non-owning view of a contiguous buffer, used to send without copying,
+//the caller has to keep the buffer alive and unchanged until the request is finished
+template <class T>
+class borrowed
+{
+private:
+    const T *_data;
+    size_t _size;
+
+public:
+    borrowed(const T *_data, size_t _size);
+
+    auto data() const -> const T *;
+    auto size() const -> size_t;
+};
+template <class T>
+auto borrow(const std::vector<T> &_value) -> borrowed<T>;
+auto borrow(const std::string &_value) -> borrowed<char>;
+#pragma endregion
+#pragma region views
+//non-contiguous part of a buffer, which is sent without packing through a cached derived datatype,
+//like a borrowed buffer the memory has to stay alive until the operation is finished
+template <class T>
+class view
+{
+private:
+    T *_data;
+    MPI_Datatype _type;
+    int _size;
+
+public:
+    view(T *_data, MPI_Datatype _type, int _size);
+
+    auto data() const -> T *;
+    auto type() const -> MPI_Datatype;
+    //number of elements in the view
+    auto size() const -> int;
+};
+//_count blocks of _blocklength elements, which start _stride elements apart
+template <class T>
+auto strided(T *_data, int _count, int _blocklength, int _stride) -> view<T>;
+template <class T>
+auto strided(std::vector<T> &_data, int _count, int _blocklength, int _stride, size_t _offset = 0) -> view<T>;
+//one column of a row-major matrix
+template <class T>
+auto column(std::vector<T> &_matrix, int _columns, int _column) -> view<T>;
+//block of a row-major array with any number of dimensions
+template <class T>
+auto subarray(T *_data, const std::vector<int> &_sizes, const std::vector<int> &_subsizes, const std::vector<int> &_starts) -> view<T>;
+template <class T>
+auto subarray(std::vector<T> &_data, const std::vector<int> &_sizes, const std::vector<int> &_subsizes, const std::vector<int> &_starts) -> view<T>;
+namespace impl
+{
+//builds and commits the datatype of a shape once
+template <class T>
+auto view_type(const std::vector<int> &_shape) -> MPI_Datatype;
+} // namespace impl
+#pragma endregion
+#pragma region serialization
+namespace impl
+{
+//containers of non-trivial elements are packed into one byte buffer and sent as a single message
+template <class T>
+struct is_serialized : std::false_type
+{
+};
+template <class T, class A>
+struct is_serialized<std::vector<T, A>> : std::integral_constant<bool, !std::is_trivially_copyable<T>::value>
+{
+};
+template <class K, class V, class C, class A>
+struct is_serialized<std::map<K, V, C, A>> : std::true_type
+{
+};
+template <class K, class V, class H, class E, class A>
+struct is_serialized<std::unordered_map<K, V, H, E, A>> : std::true_type
+{
+};
+template <class K, class C, class A>
+struct is_serialized<std::set<K, C, A>> : std::true_type
+{
+};
+//byte buffers are recycled, so repeated messages do not allocate again
+auto arena_acquire() -> std::vector<char>;
+auto arena_release(std::vector<char> &&_buffer) -> void;
+//packed form of a value, its buffer is taken from the arena and returned on destruction
+class packed
+{
+private:
+    std::vector<char> _buffer;
+
+public:
+    packed() = default;
+    template <class T>
+    explicit packed(const T &_value);
+    packed(packed &&) = default;
+    auto operator=(packed &&) -> packed & = default;
+    ~packed();
+
+    auto data() -> char *;
+    auto data() const -> const char *;
+    auto size() const -> size_t;
+    auto resize(size_t _size) -> void;
+    template <class T>
+    auto unpack(T &_value) const -> void;
+};
+//nonblocking sends keep the packed buffer instead of the value
+template <class T, class = void>
+struct send_buffer
+{
+    using type = T;
+};
+template <class T>
+struct send_buffer<T, std::enable_if_t<is_serialized<T>::value>>
+{
+    using type = packed;
+};
+} // namespace impl
+#pragma endregion
 #pragma region init
 class mpi
 {
@@ -126,13 +355,56 @@ public:
 };
 auto version() -> version_info;
 #pragma endregion
+#pragma region hierarchy
+//collectives can run node-aware, first inside every shared memory node and then among one leader per node,
+//all processes have to use the same mode for the same call
+enum class hierarchy
+{
+    flat,       //one collective over the whole communicator
+    node_aware, //two levels, non-commutative operations still run flat
+};
+namespace impl
+{
+//node layout of a communicator, cached as an attribute and built by the first node-aware collective
+struct hierarchy_info
+{
+    hierarchy _mode = hierarchy::flat;
+    bool is_built = false;
+    //a single node or a single process per node gains nothing from two levels
+    bool is_flat = false;
+    //the ranks of every node are contiguous, so gathered data needs no reordering
+    bool is_ordered = false;
+    MPI_Comm _node = MPI_COMM_NULL;
+    //only valid on the node leaders
+    MPI_Comm _leaders = MPI_COMM_NULL;
+    //rank in _leaders of the node leader of every process
+    std::vector<int> _leader_of;
+    //rank in _node of every process
+    std::vector<int> _node_rank;
+    //process count of every node, by leader rank
+    std::vector<int> _node_sizes;
+    //processes sorted by node, in rank order inside a node
+    std::vector<int> _order;
+};
+auto get_hierarchy(MPI_Comm _comm) -> hierarchy;
+auto set_hierarchy(MPI_Comm _comm, hierarchy _mode) -> void;
+//both are collective on first use
+auto node_info(MPI_Comm _comm) -> const hierarchy_info &;
+//returns nullptr if the collective should run flat
+auto node_layout(MPI_Comm _comm, hierarchy _mode) -> const hierarchy_info *;
+} // namespace impl
+#pragma endregion
 
 #pragma region communicator
 //declarations
 class sender;
 class receiver;
 class op;
+class cart_communicator;
+class graph_communicator;
+class reduction_batch;
 class ibarrier_request;
+class idup_reply;
 template <class T>
 class iallgather_request;
 template <class T>
@@ -142,17 +414,64 @@ class ialltoall_request;
 template <class T>
 class ialltoall_reply;
 template <class T>
+class iallgatherv_request;
+template <class T>
+class ialltoallv_request;
+template <class T>
+class ineighbor_allgather_request;
+template <class T>
+class ineighbor_alltoall_request;
+template <class T>
+class iscan_request;
+template <class T>
+class iexscan_request;
+template <class T>
+class ireduce_scatter_request;
+template <class T>
+class ireduce_scatter_block_request;
+template <class T>
 class iallreduce_request;
 template <class T>
 class iallreduce_reply;
+template <class T>
+class allgather_init_request;
+template <class T>
+class alltoall_init_request;
+template <class T>
+class allreduce_init_request;
+template <class T>
+class shared_array;
+template <class T>
+class window;
+namespace impl
+{
+//queries for internal paths, which do not need a communicator object
+auto rank(MPI_Comm _comm) -> int;
+auto size(MPI_Comm _comm) -> int;
+} // namespace impl
 
 class communicator
 {
 protected:
     MPI_Comm _comm;
+    //filled on first use, so constructing a handle costs no MPI calls
+    mutable int _rank = MPI_UNDEFINED;
+    mutable int _size = MPI_UNDEFINED;
+    bool is_owner = false;
+
+    friend class idup_reply;
+    //takes over a communicator which was created by the wrapper, returns nullptr for MPI_COMM_NULL
+    static auto adopt(MPI_Comm _comm) -> std::unique_ptr<communicator>;
 
 public:
-    communicator(MPI_Comm _comm);
+    //refers to _comm, or owns a duplicate of it which is freed on destruction
+    communicator(MPI_Comm _comm, const bool _duplicate = false);
+    communicator(const communicator &) = delete;
+    communicator(communicator &&_other);
+    virtual ~communicator();
+
+    auto operator=(const communicator &) -> communicator & = delete;
+    auto operator=(communicator &&_other) -> communicator &;
 
     enum class comp
     {
@@ -175,18 +494,57 @@ public:
     auto operator==(const MPI_Comm &rhs) -> bool;
     auto operator!=(const MPI_Comm &rhs) -> bool;
 
-    auto size() -> int;
-    auto rank() -> int;
-    auto name() -> std::string;
-
-    auto dest(int _dest) -> std::unique_ptr<sender>;
-    auto source(int _source) -> std::unique_ptr<receiver>;
-
+    auto size() const -> int;
+    auto rank() const -> int;
+    auto name() const -> std::string;
+    auto get() const -> MPI_Comm;
+    //default mode of the collectives which take no hierarchy argument
+    auto set_hierarchy(hierarchy _mode) -> void;
+    auto get_hierarchy() const -> hierarchy;
+
+    auto dest(int _dest, int _tag = 0) -> sender;
+    auto source(int _source, int _tag = 0) -> receiver;
+
+#pragma region construction
+    //all of these return owning communicators, or nullptr if the calling process is not part of the result
+    auto dup() -> std::unique_ptr<communicator>;
+    auto idup() -> std::unique_ptr<idup_reply>;
+    auto split(int _color, int _key = 0) -> std::unique_ptr<communicator>;
+    auto split_type(int _type = MPI_COMM_TYPE_SHARED, int _key = 0) -> std::unique_ptr<communicator>;
+    //collective over this communicator, _ranks are the ranks in this communicator
+    auto create(const std::vector<int> &_ranks) -> std::unique_ptr<communicator>;
+    //only collective over the processes in _ranks
+    auto create_group(const std::vector<int> &_ranks, int _tag = 0) -> std::unique_ptr<communicator>;
+    //with _reorder MPI may renumber the processes to match the hardware, zero entries of _dims are filled in,
+    //processes outside a smaller grid get nullptr
+    auto cart_create(std::vector<int> _dims, const std::vector<bool> &_periods, const bool _reorder = true) -> std::unique_ptr<cart_communicator>;
+    //_sources send to this process, _destinations receive from it
+    auto dist_graph_create_adjacent(const std::vector<int> &_sources, const std::vector<int> &_destinations, const bool _reorder = true) -> std::unique_ptr<graph_communicator>;
+#pragma endregion
+#pragma region shared memory
+    //collective, every shared memory node gets its own array of _size elements
+    template <class T>
+    auto allocate_shared(size_t _size) -> shared_array<T>;
+#pragma endregion
+#pragma region one-sided
+    //collective, every process exposes _size elements which are allocated by MPI
+    template <class T>
+    auto allocate_window(size_t _size) -> window<T>;
+    //collective, every process exposes its vector, which has to outlive the window and must not be resized
+    template <class T>
+    auto create_window(std::vector<T> &_memory) -> window<T>;
+#pragma endregion
 #pragma region allgather
     template <class T>
     auto allgather(const T &_value, std::vector<T> &_bucket) -> void;
     template <class T>
     auto allgather(const std::vector<T> &_value, std::vector<T> &_bucket) -> void;
+    template <class T>
+    auto allgather(const T &_value, std::vector<T> &_bucket, hierarchy _mode) -> void;
+    template <class T>
+    auto allgather(const std::vector<T> &_value, std::vector<T> &_bucket, hierarchy _mode) -> void;
+    template <class T>
+    auto allgather(view<T> _value, std::vector<T> &_bucket) -> void;
     auto allgather(const char _value, std::string &_bucket) -> void;
     auto allgather(const char *_value, std::string &_bucket) -> void;
     auto allgather(const std::string &_value, std::string &_bucket) -> void;
@@ -246,6 +604,32 @@ public:
     auto ialltoall(const char *_value, const size_t _chunk_size) -> std::unique_ptr<ialltoall_reply<std::string>>;
     auto ialltoall(const std::string &_value, const size_t _chunk_size) -> std::unique_ptr<ialltoall_reply<std::string>>;
 #pragma endregion
+#pragma region allgatherv
+    //without counts they are exchanged first, with counts every process has to pass the same ones
+    template <class T>
+    auto allgatherv(const std::vector<T> &_value, std::vector<T> &_bucket) -> void;
+    template <class T>
+    auto allgatherv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> void;
+    template <class T>
+    auto allgatherv(const std::vector<T> &_value) -> std::vector<T>;
+    template <class T>
+    auto iallgatherv(const std::vector<T> &_value, std::vector<T> &_bucket) -> std::unique_ptr<iallgatherv_request<std::vector<T>>>;
+    template <class T>
+    auto iallgatherv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> std::unique_ptr<iallgatherv_request<std::vector<T>>>;
+#pragma endregion
+#pragma region alltoallv
+    //_send_counts holds the number of elements for every process, the receive counts are exchanged unless passed
+    template <class T>
+    auto alltoallv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_send_counts) -> void;
+    template <class T>
+    auto alltoallv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_send_counts, const std::vector<size_t> &_recv_counts) -> void;
+    template <class T>
+    auto alltoallv(const std::vector<T> &_value, const std::vector<size_t> &_send_counts) -> std::vector<T>;
+    template <class T>
+    auto ialltoallv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_send_counts) -> std::unique_ptr<ialltoallv_request<std::vector<T>>>;
+    template <class T>
+    auto ialltoallv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_send_counts, const std::vector<size_t> &_recv_counts) -> std::unique_ptr<ialltoallv_request<std::vector<T>>>;
+#pragma endregion
 #pragma region barrier
     auto barrier() -> void;
 #pragma endregion
@@ -257,6 +641,10 @@ public:
     auto allreduce(const T &_value, T &_bucket, op *_operation) -> void;
     template <class T>
     auto allreduce(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void;
+    template <class T>
+    auto allreduce(const T &_value, T &_bucket, op *_operation, hierarchy _mode) -> void;
+    template <class T>
+    auto allreduce(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation, hierarchy _mode) -> void;
     auto allreduce(const char _value, std::string &_bucket, op *_operation) -> void;
     auto allreduce(const char *_value, std::string &_bucket, op *_operation) -> void;
     auto allreduce(const std::string &_value, std::string &_bucket, op *_operation) -> void;
@@ -272,6 +660,10 @@ public:
     auto allreduce(const T &_value, T &_bucket, Op _operation) -> void;
     template <class T, class Op>
     auto allreduce(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> void;
+    template <class T, class Op>
+    auto allreduce(const T &_value, T &_bucket, Op _operation, hierarchy _mode) -> void;
+    template <class T, class Op>
+    auto allreduce(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation, hierarchy _mode) -> void;
     template <class Op>
     auto allreduce(const char _value, std::string &_bucket, Op _operation) -> void;
     template <class Op>
@@ -326,6 +718,278 @@ public:
     template <class Op>
     auto iallreduce(const std::string &_value, Op _operation) -> std::unique_ptr<iallreduce_reply<std::string>>;
 #pragma endregion
+#pragma region scan
+    //inclusive prefix reduction over the ranks, exscan leaves out the own value and gives the first process a value-initialized result
+    template <class T>
+    auto scan(const T &_value, T &_bucket, op *_operation) -> void;
+    template <class T>
+    auto scan(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void;
+    template <class T>
+    auto scan(const T &_value, op *_operation) -> T;
+    template <class T>
+    auto scan(const std::vector<T> &_value, op *_operation) -> std::vector<T>;
+    template <class T>
+    auto exscan(const T &_value, T &_bucket, op *_operation) -> void;
+    template <class T>
+    auto exscan(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void;
+    template <class T>
+    auto exscan(const T &_value, op *_operation) -> T;
+    template <class T>
+    auto exscan(const std::vector<T> &_value, op *_operation) -> std::vector<T>;
+
+    template <class T, class Op>
+    auto scan(const T &_value, T &_bucket, Op _operation) -> void;
+    template <class T, class Op>
+    auto scan(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> void;
+    template <class T, class Op>
+    auto scan(const T &_value, Op _operation) -> T;
+    template <class T, class Op>
+    auto scan(const std::vector<T> &_value, Op _operation) -> std::vector<T>;
+    template <class T, class Op>
+    auto exscan(const T &_value, T &_bucket, Op _operation) -> void;
+    template <class T, class Op>
+    auto exscan(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> void;
+    template <class T, class Op>
+    auto exscan(const T &_value, Op _operation) -> T;
+    template <class T, class Op>
+    auto exscan(const std::vector<T> &_value, Op _operation) -> std::vector<T>;
+#pragma endregion
+#pragma region iscan
+    template <class T>
+    auto iscan(const T &_value, T &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iscan_request<T>>;
+    template <class T>
+    auto iscan(const std::vector<T> &_value, std::vector<T> &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iscan_request<std::vector<T>>>;
+    template <class T>
+    auto iexscan(const T &_value, T &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iexscan_request<T>>;
+    template <class T>
+    auto iexscan(const std::vector<T> &_value, std::vector<T> &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iexscan_request<std::vector<T>>>;
+
+    template <class T, class Op>
+    auto iscan(const T &_value, T &_bucket, Op _operation) -> std::unique_ptr<iscan_request<T>>;
+    template <class T, class Op>
+    auto iscan(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> std::unique_ptr<iscan_request<std::vector<T>>>;
+    template <class T, class Op>
+    auto iexscan(const T &_value, T &_bucket, Op _operation) -> std::unique_ptr<iexscan_request<T>>;
+    template <class T, class Op>
+    auto iexscan(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> std::unique_ptr<iexscan_request<std::vector<T>>>;
+#pragma endregion
+#pragma region reduce_scatter
+    //the elementwise result is split up, process i keeps _counts[i] elements or, for the block version, an equal share
+    template <class T>
+    auto reduce_scatter(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, op *_operation) -> void;
+    template <class T>
+    auto reduce_scatter(const std::vector<T> &_value, const std::vector<size_t> &_counts, op *_operation) -> std::vector<T>;
+    template <class T>
+    auto reduce_scatter_block(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void;
+    template <class T>
+    auto reduce_scatter_block(const std::vector<T> &_value, op *_operation) -> std::vector<T>;
+
+    template <class T, class Op>
+    auto reduce_scatter(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, Op _operation) -> void;
+    template <class T, class Op>
+    auto reduce_scatter(const std::vector<T> &_value, const std::vector<size_t> &_counts, Op _operation) -> std::vector<T>;
+    template <class T, class Op>
+    auto reduce_scatter_block(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> void;
+    template <class T, class Op>
+    auto reduce_scatter_block(const std::vector<T> &_value, Op _operation) -> std::vector<T>;
+#pragma endregion
+#pragma region ireduce_scatter
+    template <class T>
+    auto ireduce_scatter(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, std::shared_ptr<op> _operation) -> std::unique_ptr<ireduce_scatter_request<std::vector<T>>>;
+    template <class T>
+    auto ireduce_scatter_block(const std::vector<T> &_value, std::vector<T> &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<ireduce_scatter_block_request<std::vector<T>>>;
+
+    template <class T, class Op>
+    auto ireduce_scatter(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, Op _operation) -> std::unique_ptr<ireduce_scatter_request<std::vector<T>>>;
+    template <class T, class Op>
+    auto ireduce_scatter_block(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> std::unique_ptr<ireduce_scatter_block_request<std::vector<T>>>;
+#pragma endregion
+#pragma region neighbor collectives
+    //only for communicators with a topology, the bucket holds one chunk per source in neighbor order,
+    //chunks of MPI_PROC_NULL neighbors are left untouched
+    template <class T>
+    auto neighbor_allgather(const T &_value, std::vector<T> &_bucket) -> void;
+    template <class T>
+    auto neighbor_allgather(const std::vector<T> &_value, std::vector<T> &_bucket) -> void;
+    template <class T>
+    auto neighbor_allgather(const T &_value) -> std::vector<T>;
+    template <class T>
+    auto neighbor_allgather(const std::vector<T> &_value) -> std::vector<T>;
+    //_value holds one chunk of _chunk_size elements per destination
+    template <class T>
+    auto neighbor_alltoall(const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void;
+    template <class T>
+    auto neighbor_alltoall(const std::vector<T> &_value, const size_t _chunk_size) -> std::vector<T>;
+    template <class T>
+    auto ineighbor_allgather(const T &_value, std::vector<T> &_bucket) -> std::unique_ptr<ineighbor_allgather_request<std::vector<T>>>;
+    template <class T>
+    auto ineighbor_allgather(const std::vector<T> &_value, std::vector<T> &_bucket) -> std::unique_ptr<ineighbor_allgather_request<std::vector<T>>>;
+    template <class T>
+    auto ineighbor_alltoall(const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> std::unique_ptr<ineighbor_alltoall_request<std::vector<T>>>;
+#pragma endregion
+#pragma region persistent collectives
+    //plans bind the buffers, the operation and the sizes once and are restarted with start()
+    template <class T>
+    auto allgather_init(const T &_value, std::vector<T> &_bucket) -> std::unique_ptr<allgather_init_request<T>>;
+    template <class T>
+    auto allgather_init(const std::vector<T> &_value, std::vector<T> &_bucket) -> std::unique_ptr<allgather_init_request<std::vector<T>>>;
+    template <class T>
+    auto alltoall_init(const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> std::unique_ptr<alltoall_init_request<std::vector<T>>>;
+    template <class T>
+    auto allreduce_init(const T &_value, T &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<allreduce_init_request<T>>;
+    template <class T>
+    auto allreduce_init(const std::vector<T> &_value, std::vector<T> &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<allreduce_init_request<std::vector<T>>>;
+    template <class T, class Op>
+    auto allreduce_init(const T &_value, T &_bucket, Op _operation) -> std::unique_ptr<allreduce_init_request<T>>;
+    template <class T, class Op>
+    auto allreduce_init(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> std::unique_ptr<allreduce_init_request<std::vector<T>>>;
+#pragma endregion
+#pragma region reduction batch
+    //collects small allreduces until flush() or until _threshold bytes are pending
+    auto reduction_batch(size_t _threshold = 65536) -> std::unique_ptr<::mpi::reduction_batch>;
+#pragma endregion
+};
+#pragma endregion
+#pragma region topologies
+namespace impl
+{
+//number of sources and destinations of a communicator with a topology
+auto neighbor_count(MPI_Comm _comm) -> std::pair<int, int>;
+} // namespace impl
+class cart_communicator : public communicator
+{
+    friend class communicator;
+    static auto adopt(MPI_Comm _comm) -> std::unique_ptr<cart_communicator>;
+
+public:
+    using communicator::communicator;
+    using communicator::rank;
+
+    auto dims() const -> std::vector<int>;
+    auto periods() const -> std::vector<bool>;
+    auto coords() const -> std::vector<int>;
+    auto coords(int _rank) const -> std::vector<int>;
+    auto rank(const std::vector<int> &_coords) const -> int;
+    //source and destination of a shift along _direction, MPI_PROC_NULL beyond a non-periodic border,
+    //both can be passed to source() and dest() directly
+    auto shift(int _direction, int _displacement = 1) const -> std::pair<int, int>;
+};
+class graph_communicator : public communicator
+{
+    friend class communicator;
+    static auto adopt(MPI_Comm _comm) -> std::unique_ptr<graph_communicator>;
+
+public:
+    using communicator::communicator;
+
+    auto sources() const -> std::vector<int>;
+    auto destinations() const -> std::vector<int>;
+};
+#pragma endregion
+#pragma region reduction batch
+namespace impl
+{
+//results of one flush of a group, the futures keep it alive
+template <class T>
+struct batch_round
+{
+    std::vector<T> _values;
+    bool _ready = false;
+};
+//contributions with the same element type and operation, they are reduced by one collective
+class batch_group
+{
+public:
+    virtual ~batch_group() = default;
+    //bytes waiting for the next flush
+    virtual auto pending() const -> size_t = 0;
+    //starts the reduction, returns false if there is nothing to reduce
+    virtual auto post(MPI_Comm _comm, MPI_Request *_request) -> bool = 0;
+    //marks the results as ready and starts a new round
+    virtual auto complete() -> void = 0;
+};
+template <class T>
+class typed_batch_group : public batch_group
+{
+private:
+    std::shared_ptr<op> _operation;
+    std::vector<T> _values;
+    std::shared_ptr<batch_round<T>> _round;
+
+public:
+    typed_batch_group(std::shared_ptr<op> _operation);
+
+    //returns the round and the offset of the contribution in it
+    auto add(const T *_data, size_t _size) -> std::pair<std::shared_ptr<batch_round<T>>, size_t>;
+    virtual auto pending() const -> size_t;
+    virtual auto post(MPI_Comm _comm, MPI_Request *_request) -> bool;
+    virtual auto complete() -> void;
+};
+//shared by the batch and its futures, so a future can still flush once the batch is gone
+struct batch_state
+{
+    MPI_Comm _comm;
+    size_t _threshold;
+    size_t _pending = 0;
+    //groups are flushed in the order of their first contribution, which is the same on every process
+    std::vector<std::unique_ptr<batch_group>> _groups;
+    std::map<const void *, batch_group *> _index;
+
+    batch_state(MPI_Comm _comm, size_t _threshold);
+    auto flush() -> void;
+};
+} // namespace impl
+template <class T>
+class batch_future
+{
+private:
+    std::shared_ptr<impl::batch_state> _state;
+    std::shared_ptr<impl::batch_round<T>> _round;
+    size_t _offset;
+
+public:
+    batch_future(std::shared_ptr<impl::batch_state> _state, std::shared_ptr<impl::batch_round<T>> _round, size_t _offset);
+
+    auto ready() const -> bool;
+    //flushes the batch if the value is not reduced yet, which is collective
+    auto get() const -> T;
+};
+template <class T>
+class batch_future<std::vector<T>>
+{
+private:
+    std::shared_ptr<impl::batch_state> _state;
+    std::shared_ptr<impl::batch_round<T>> _round;
+    size_t _offset;
+    size_t _size;
+
+public:
+    batch_future(std::shared_ptr<impl::batch_state> _state, std::shared_ptr<impl::batch_round<T>> _round, size_t _offset, size_t _size);
+
+    auto ready() const -> bool;
+    //flushes the batch if the value is not reduced yet, which is collective
+    auto get() const -> std::vector<T>;
+};
+//every process has to contribute the same types and operations in the same order
+class reduction_batch
+{
+private:
+    std::shared_ptr<impl::batch_state> _state;
+
+    template <class T, class Op>
+    auto group(Op _operation) -> impl::typed_batch_group<T> *;
+
+public:
+    reduction_batch(MPI_Comm _comm, size_t _threshold);
+
+    template <class T, class Op>
+    auto allreduce(const T &_value, Op _operation) -> batch_future<T>;
+    template <class T, class Op>
+    auto allreduce(const std::vector<T> &_value, Op _operation) -> batch_future<std::vector<T>>;
+    //bytes waiting for the next flush
+    auto pending() const -> size_t;
+    //collective, starts one nonblocking allreduce per group and waits for all of them
+    auto flush() -> void;
 };
 #pragma endregion
 #pragma region comm
@@ -338,15 +1002,169 @@ auto compare(const communicator &lhs, const MPI_Comm &rhs) -> communicator::comp
 auto compare(const MPI_Comm &lhs, const communicator &rhs) -> communicator::comp;
 auto compare(const communicator &lhs, const communicator &rhs) -> communicator::comp;
 #pragma endregion
+#pragma region shared memory
+//one array per shared memory node, which every process of the node maps directly,
+//the first process of every node allocates the memory
+template <class T>
+class shared_array
+{
+    static_assert(std::is_trivially_copyable<T>::value, "shared memory can only hold trivially copyable types");
+
+private:
+    MPI_Comm _comm = MPI_COMM_NULL;
+    MPI_Win _window = MPI_WIN_NULL;
+    T *_data = nullptr;
+    size_t _size = 0;
+
+    auto release() -> void;
+
+public:
+    //collective over _comm, which is split into its shared memory nodes
+    shared_array(MPI_Comm _comm, size_t _size);
+    shared_array(const shared_array &) = delete;
+    shared_array(shared_array &&_other);
+    ~shared_array();
+
+    auto operator=(const shared_array &) -> shared_array & = delete;
+    auto operator=(shared_array &&_other) -> shared_array &;
+
+    auto operator[](size_t _index) -> T &;
+    auto operator[](size_t _index) const -> const T &;
+    auto data() -> T *;
+    auto data() const -> const T *;
+    auto begin() -> T *;
+    auto begin() const -> const T *;
+    auto end() -> T *;
+    auto end() const -> const T *;
+    auto size() const -> size_t;
+    auto get() const -> MPI_Win;
+
+    //rank and size inside the node, local rank 0 owns the memory
+    auto local_rank() const -> int;
+    auto local_size() const -> int;
+    //collective over the node, makes the writes of every process visible to the others
+    auto sync() -> void;
+};
+#pragma endregion
+#pragma region one-sided
+template <class T>
+class rput_request;
+template <class T>
+class rget_request;
+enum class lock_type
+{
+    shared,
+    exclusive,
+};
+//memory which other processes read and write without the owner taking part,
+//offsets count elements from the start of the target's window
+template <class T>
+class window
+{
+    static_assert(std::is_trivially_copyable<T>::value, "windows can only hold trivially copyable types");
+
+private:
+    MPI_Comm _comm = MPI_COMM_NULL;
+    MPI_Win _window = MPI_WIN_NULL;
+    T *_data = nullptr;
+    size_t _size = 0;
+
+    auto release() -> void;
+
+public:
+    //collective over _comm, allocates _size elements per process
+    window(MPI_Comm _comm, size_t _size);
+    //collective over _comm, exposes the memory of the vector
+    window(MPI_Comm _comm, std::vector<T> &_memory);
+    window(const window &) = delete;
+    window(window &&_other);
+    ~window();
+
+    auto operator=(const window &) -> window & = delete;
+    auto operator=(window &&_other) -> window &;
+
+    //the local part of the window
+    auto operator[](size_t _index) -> T &;
+    auto operator[](size_t _index) const -> const T &;
+    auto data() -> T *;
+    auto data() const -> const T *;
+    auto size() const -> size_t;
+    auto get() const -> MPI_Win;
+
+#pragma region epochs
+    auto fence(int _assert = 0) -> void;
+    auto lock(int _target, lock_type _type = lock_type::shared, int _assert = 0) -> void;
+    auto unlock(int _target) -> void;
+    auto lock_all(int _assert = 0) -> void;
+    auto unlock_all() -> void;
+    auto flush(int _target) -> void;
+    auto flush_all() -> void;
+    auto flush_local(int _target) -> void;
+    auto flush_local_all() -> void;
+    auto sync() -> void;
+#pragma endregion
+#pragma region put
+    auto put(const T &_value, int _target, size_t _offset) -> void;
+    auto put(const std::vector<T> &_value, int _target, size_t _offset) -> void;
+#pragma endregion
+#pragma region get
+    //a vector bucket receives as many elements as it holds
+    auto get(T &_bucket, int _target, size_t _offset) -> void;
+    auto get(std::vector<T> &_bucket, int _target, size_t _offset) -> void;
+#pragma endregion
+#pragma region accumulate
+    //only predefined operations like mpi::sum or mpi::replace can be used
+    template <class Op>
+    auto accumulate(const T &_value, int _target, size_t _offset, Op _operation) -> void;
+    template <class Op>
+    auto accumulate(const std::vector<T> &_value, int _target, size_t _offset, Op _operation) -> void;
+    template <class Op>
+    auto get_accumulate(const T &_value, T &_bucket, int _target, size_t _offset, Op _operation) -> void;
+    template <class Op>
+    auto get_accumulate(const std::vector<T> &_value, std::vector<T> &_bucket, int _target, size_t _offset, Op _operation) -> void;
+    template <class Op>
+    auto fetch_and_op(const T &_value, T &_bucket, int _target, size_t _offset, Op _operation) -> void;
+    auto compare_and_swap(const T &_value, const T &_compare, T &_bucket, int _target, size_t _offset) -> void;
+#pragma endregion
+#pragma region request-based
+    //only inside a lock or lock_all epoch
+    auto rput(const T &_value, int _target, size_t _offset) -> std::unique_ptr<rput_request<T>>;
+    auto rput(const std::vector<T> &_value, int _target, size_t _offset) -> std::unique_ptr<rput_request<std::vector<T>>>;
+    auto rput(std::vector<T> &&_value, int _target, size_t _offset) -> std::unique_ptr<rput_request<std::vector<T>>>;
+    auto rget(T &_bucket, int _target, size_t _offset) -> std::unique_ptr<rget_request<T>>;
+    auto rget(std::vector<T> &_bucket, int _target, size_t _offset) -> std::unique_ptr<rget_request<std::vector<T>>>;
+#pragma endregion
+};
+#pragma endregion
 #pragma region operation wrapper
+namespace impl
+{
+//one address per combination of types, it identifies the combination in the caches
+template <class... T>
+auto type_key() -> const void *;
+//make_op creates every operation once and keeps it until MPI_Finalize
+auto find_op(const void *_key, const bool _commute) -> std::shared_ptr<op>;
+auto register_op(const void *_key, const bool _commute, std::shared_ptr<op> _operation) -> void;
+//attribute key under which operations with captures store themselves on their datatype
+auto op_keyval() -> int;
+//called by ~mpi, frees the user-defined handles, even those of operations that are still referenced
+auto free_ops() -> void;
+} // namespace impl
 class op
 {
+    friend auto impl::free_ops() -> void;
+
 protected:
     MPI_Op _operation;
     const bool _commute;
+    //own copy of the datatype for operations with captures, MPI_DATATYPE_NULL otherwise
+    MPI_Datatype _type = MPI_DATATYPE_NULL;
     op(MPI_Op _operation, const bool _commute);
     op(const bool _commute);
 
+    //frees a user-defined handle, builtin operations have nothing to free
+    virtual auto release() -> void;
+
 public:
     op(const op &) = delete;
     op(op &&) = delete;
@@ -356,27 +1174,91 @@ public:
 
     auto get() const -> const MPI_Op &;
     auto commutes() const -> bool;
+    //datatype to reduce with, operations with captures replace the given one by their own copy
+    auto type(MPI_Datatype _base) const -> MPI_Datatype;
 };
 
 template <class T, class Op>
 class op_proxy : public op
 {
 private:
-    static auto wrapper(void *void_a, void *void_b, int *len, MPI_Datatype *) -> void;
+    static auto wrapper(void *void_a, void *void_b, int *len, MPI_Datatype *type) -> void;
 
 public:
     using op::op;
 
     op_proxy(const bool _commute);
     virtual ~op_proxy();
+
+protected:
+    virtual auto release() -> void;
 };
+//operations with captures cannot be rebuilt from their type inside the wrapper,
+//so they are kept here and reached through an attribute of their own datatype, which MPI passes to every call
+template <class T, class Op>
+class capture_proxy : public op
+{
+private:
+    Op _func;
+    static auto wrapper(void *void_a, void *void_b, int *len, MPI_Datatype *type) -> void;
 
+public:
+    capture_proxy(Op _func, const bool _commute);
+    virtual ~capture_proxy();
+
+protected:
+    virtual auto release() -> void;
+};
+
+//pure lambdas and functors are created once per type, operations with captures for every call
 template <class T, class Op>
 auto make_op(Op _func, const bool _commute = false) -> std::shared_ptr<op>;
+//block kernels reduce a whole range in one call, kernel(const T *in, T *inout, size_t n) has to compute inout[i] = in[i] op inout[i],
+//pass the kernel to mpi::blockwise(...), or to mpi::blockwise<true>(...) if the operation commutes
+template <class Kernel, bool Commute = false>
+struct blockwise_op
+{
+    Kernel _kernel;
+};
+template <bool Commute = false, class Kernel>
+constexpr auto blockwise(Kernel _kernel) -> blockwise_op<Kernel, Commute>;
+//a tuple of operations reduces a tuple elementwise, so several scalar reductions share one collective:
+//allreduce(std::make_tuple(norm, iterations, error), std::make_tuple(mpi::sum, mpi::sum, mpi::max))
+template <class T, class... Op>
+auto make_op(std::tuple<Op...> _func, const bool _commute = false) -> std::shared_ptr<op>;
 #pragma endregion
 #pragma region request
+class request;
+class request_set;
+namespace impl
+{
+//nonblocking receives of dynamically sized data are only posted once their message was probed,
+//this queue makes sure that they are still matched in the order they were issued
+class receive_queue
+{
+private:
+    struct entry
+    {
+        request *_request;
+        MPI_Comm _comm;
+        int _source;
+        int _tag;
+    };
+    static auto entries() -> std::vector<entry> &;
+
+public:
+    static auto push(request *_request, MPI_Comm _comm, int _source, int _tag) -> void;
+    static auto pop(request *_request) -> void;
+    //checks if no earlier receive could match the same message, blocking posts the earlier receives instead
+    static auto is_next(request *_request, MPI_Comm _comm, int _source, int _tag, const bool _blocking) -> bool;
+    //posts the queued receives of a set in order, returns false if some of them are still waiting for their message
+    static auto post(request_set *_set, const bool _blocking) -> bool;
+};
+} // namespace impl
 class request
 {
+    friend class impl::receive_queue;
+
     friend auto testall(const std::vector<request *> &_values) -> bool;
     friend auto testany(const std::vector<request *> &_values) -> std::vector<size_t>;
     friend auto testsome(const std::vector<request *> &_values) -> std::vector<size_t>;
@@ -385,16 +1267,30 @@ class request
     friend auto waitany(const std::vector<request *> &_values) -> std::vector<size_t>;
     friend auto waitsome(const std::vector<request *> &_values) -> std::vector<size_t>;
 
+    friend class request_set;
+
 protected:
     MPI_Comm _comm;
     MPI_Request _request;
+    //where the handle lives, a request_set moves it into its own storage
+    MPI_Request *_handle;
+    request_set *_set = nullptr;
+    size_t _slot = 0;
     MPI_Status _status;
     bool is_finished = false;
     bool is_canceled = false;
 
     request(MPI_Comm _comm);
+    request(const request &) = delete;
+    request &operator=(const request &) = delete;
     virtual ~request();
 
+    //advances the request until _request is a valid handle, returns false while this is not the case
+    virtual auto post(const bool _blocking) -> bool;
+    //called once after the request was finished
+    virtual auto complete() -> void;
+    auto finish() -> void;
+
 public:
     virtual auto cancel() -> void;
     virtual auto test() -> bool;
@@ -409,6 +1305,18 @@ public:
     ibarrier_request(MPI_Comm _comm);
 };
 #pragma endregion
+#pragma region idup
+class idup_reply : public request
+{
+private:
+    MPI_Comm _newcomm;
+
+public:
+    idup_reply(MPI_Comm _comm);
+    virtual ~idup_reply();
+    auto get() -> std::unique_ptr<communicator>;
+};
+#pragma endregion
 #pragma region isend
 template <class T>
 class isend_request : public request
@@ -416,10 +1324,10 @@ class isend_request : public request
 private:
     int _dest;
     int _tag;
-    T _value;
+    typename impl::send_buffer<T>::type _value;
 
 public:
-    isend_request(int _dest, int _tag, MPI_Comm _comm, const T &_value);
+    isend_request(int _dest, int _tag, MPI_Comm _comm, T _value);
 };
 #pragma endregion
 #pragma region issend
@@ -429,10 +1337,10 @@ class issend_request : public request
 private:
     int _dest;
     int _tag;
-    T _value;
+    typename impl::send_buffer<T>::type _value;
 
 public:
-    issend_request(int _dest, int _tag, MPI_Comm _comm, const T &_value);
+    issend_request(int _dest, int _tag, MPI_Comm _comm, T _value);
 };
 #pragma endregion
 #pragma region irsend
@@ -445,7 +1353,35 @@ private:
     T _value;
 
 public:
-    irsend_request(int _dest, int _tag, MPI_Comm _comm, const T &_value);
+    irsend_request(int _dest, int _tag, MPI_Comm _comm, T _value);
+};
+#pragma endregion
+#pragma region rput
+template <class T>
+class rput_request : public request
+{
+private:
+    int _target;
+    MPI_Aint _offset;
+    MPI_Win _window;
+    T _value;
+
+public:
+    rput_request(int _target, MPI_Aint _offset, MPI_Win _window, MPI_Comm _comm, T _value);
+};
+#pragma endregion
+#pragma region rget
+template <class T>
+class rget_request : public request
+{
+private:
+    int _target;
+    MPI_Aint _offset;
+    MPI_Win _window;
+    T &_bucket;
+
+public:
+    rget_request(int _target, MPI_Aint _offset, MPI_Win _window, MPI_Comm _comm, T &_bucket);
 };
 #pragma endregion
 #pragma region irecv
@@ -455,22 +1391,100 @@ class irecv_request : public request
 private:
     int _source;
     int _tag;
+    bool is_posted = false;
+    T &_bucket;
+
+protected:
+    virtual auto post(const bool _blocking) -> bool;
 
 public:
     irecv_request(int _source, int _tag, MPI_Comm _comm, T &_value);
 };
+template <class T>
+class irecv_request<view<T>> : public request
+{
+private:
+    int _source;
+    int _tag;
+    bool is_posted = false;
+    view<T> _bucket;
+
+protected:
+    virtual auto post(const bool _blocking) -> bool;
+
+public:
+    irecv_request(int _source, int _tag, MPI_Comm _comm, view<T> _value);
+};
+template <class T>
+class irecv_request<std::vector<T>> : public request
+{
+private:
+    int _source;
+    int _tag;
+    MPI_Message _message;
+    bool is_posted = false;
+    impl::packed _packed;
+    std::vector<T> &_bucket;
+
+protected:
+    virtual auto post(const bool _blocking) -> bool;
+    virtual auto complete() -> void;
+
+public:
+    irecv_request(int _source, int _tag, MPI_Comm _comm, std::vector<T> &_value);
+};
+//maps and sets are always packed, so they are probed and unpacked like vectors of non-trivial elements
+template <class T>
+class irecv_packed_request : public request
+{
+private:
+    int _source;
+    int _tag;
+    MPI_Message _message;
+    bool is_posted = false;
+    impl::packed _packed;
+    T &_bucket;
+
+protected:
+    virtual auto post(const bool _blocking) -> bool;
+    virtual auto complete() -> void;
+
+public:
+    irecv_packed_request(int _source, int _tag, MPI_Comm _comm, T &_value);
+};
+template <class K, class V, class C, class A>
+class irecv_request<std::map<K, V, C, A>> : public irecv_packed_request<std::map<K, V, C, A>>
+{
+public:
+    using irecv_packed_request<std::map<K, V, C, A>>::irecv_packed_request;
+};
+template <class K, class V, class H, class E, class A>
+class irecv_request<std::unordered_map<K, V, H, E, A>> : public irecv_packed_request<std::unordered_map<K, V, H, E, A>>
+{
+public:
+    using irecv_packed_request<std::unordered_map<K, V, H, E, A>>::irecv_packed_request;
+};
+template <class K, class C, class A>
+class irecv_request<std::set<K, C, A>> : public irecv_packed_request<std::set<K, C, A>>
+{
+public:
+    using irecv_packed_request<std::set<K, C, A>>::irecv_packed_request;
+};
 template <>
 class irecv_request<std::string> : public request
 {
 private:
     int _source;
     int _tag;
-    std::unique_ptr<char[]> _c_str;
+    MPI_Message _message;
+    bool is_posted = false;
     std::string &_bucket;
 
+protected:
+    virtual auto post(const bool _blocking) -> bool;
+
 public:
     irecv_request(int _source, int _tag, MPI_Comm _comm, std::string &_value);
-    virtual auto wait() -> void;
 };
 
 template <class T>
@@ -479,19 +1493,85 @@ class irecv_reply : public request
 private:
     int _source;
     int _tag;
+    bool is_posted = false;
     T _bucket;
 
+protected:
+    virtual auto post(const bool _blocking) -> bool;
+
 public:
     irecv_reply(int _source, int _tag, MPI_Comm _comm);
     auto get() -> T;
 };
+template <class T>
+class irecv_reply<std::vector<T>> : public request
+{
+private:
+    int _source;
+    int _tag;
+    MPI_Message _message;
+    bool is_posted = false;
+    impl::packed _packed;
+    std::vector<T> _bucket;
+
+protected:
+    virtual auto post(const bool _blocking) -> bool;
+    virtual auto complete() -> void;
+
+public:
+    irecv_reply(int _source, int _tag, MPI_Comm _comm);
+    auto get() -> std::vector<T>;
+};
+//maps and sets are always packed, like their irecv_request
+template <class T>
+class irecv_packed_reply : public request
+{
+private:
+    int _source;
+    int _tag;
+    MPI_Message _message;
+    bool is_posted = false;
+    impl::packed _packed;
+    T _bucket;
+
+protected:
+    virtual auto post(const bool _blocking) -> bool;
+    virtual auto complete() -> void;
+
+public:
+    irecv_packed_reply(int _source, int _tag, MPI_Comm _comm);
+    auto get() -> T;
+};
+template <class K, class V, class C, class A>
+class irecv_reply<std::map<K, V, C, A>> : public irecv_packed_reply<std::map<K, V, C, A>>
+{
+public:
+    using irecv_packed_reply<std::map<K, V, C, A>>::irecv_packed_reply;
+};
+template <class K, class V, class H, class E, class A>
+class irecv_reply<std::unordered_map<K, V, H, E, A>> : public irecv_packed_reply<std::unordered_map<K, V, H, E, A>>
+{
+public:
+    using irecv_packed_reply<std::unordered_map<K, V, H, E, A>>::irecv_packed_reply;
+};
+template <class K, class C, class A>
+class irecv_reply<std::set<K, C, A>> : public irecv_packed_reply<std::set<K, C, A>>
+{
+public:
+    using irecv_packed_reply<std::set<K, C, A>>::irecv_packed_reply;
+};
 template <>
 class irecv_reply<std::string> : public request
 {
 private:
     int _source;
     int _tag;
-    std::unique_ptr<char[]> _c_str;
+    MPI_Message _message;
+    bool is_posted = false;
+    std::string _bucket;
+
+protected:
+    virtual auto post(const bool _blocking) -> bool;
 
 public:
     irecv_reply(int _source, int _tag, MPI_Comm _comm);
@@ -508,346 +1588,455 @@ private:
 public:
     ibcast_request(int _source, MPI_Comm _comm, T &_value);
 };
-template <>
-class ibcast_request<std::string> : public request
+template <class T>
+class ibcast_reply : public request
 {
 private:
     int _source;
-    std::unique_ptr<char[]> _c_str;
-    std::string &_bucket;
+    T _bucket;
 
 public:
-    ibcast_request(int _source, MPI_Comm _comm, std::string &_value);
-    virtual auto wait() -> void;
+    ibcast_reply(int _source, MPI_Comm _comm, const T &_value);
+    auto get() -> T;
+};
+#pragma endregion
+#pragma region iscatter
+template <class T>
+class iscatter_request : public request
+{
+private:
+    int _source;
+    size_t _chunk_size;
+    T _value;
+    T &_bucket;
+
+public:
+    iscatter_request(int _source, MPI_Comm _comm, const T &_value, T &_bucket, const size_t _chunk_size);
+};
+template <class T>
+class iscatter_reply : public request
+{
+private:
+    int _source;
+    size_t _chunk_size;
+    T _value;
+    T _bucket;
+
+public:
+    iscatter_reply(int _source, MPI_Comm _comm, const T &_value, const size_t _chunk_size);
+    auto get() -> T;
+};
+#pragma endregion
+#pragma region igather
+template <class T>
+class igather_request : public request
+{
+private:
+    int _dest;
+    T _value;
+    T &_bucket;
+
+public:
+    igather_request(int _dest, MPI_Comm _comm, const T &_value, T &_bucket);
+};
+template <class T>
+class igather_reply : public request
+{
+private:
+    int _dest;
+    T _value;
+    T _bucket;
+
+public:
+    igather_reply(int _dest, MPI_Comm _comm, const T &_value);
+    auto get() -> T;
+};
+#pragma endregion
+#pragma region iallgather
+template <class T>
+class iallgather_request : public request
+{
+private:
+    T _value;
+    T &_bucket;
+
+public:
+    iallgather_request(MPI_Comm _comm, const T &_value, T &_bucket);
+};
+template <class T>
+class iallgather_reply : public request
+{
+private:
+    T _value;
+    T _bucket;
+
+public:
+    iallgather_reply(MPI_Comm _comm, const T &_value);
+    auto get() -> T;
+};
+#pragma endregion
+#pragma region ialltoall
+template <class T>
+class ialltoall_request : public request
+{
+private:
+    size_t _chunk_size;
+    T _value;
+    T &_bucket;
+
+public:
+    ialltoall_request(MPI_Comm _comm, const T &_value, T &_bucket, const size_t _chunk_size);
 };
 template <class T>
-class ibcast_reply : public request
+class ialltoall_reply : public request
 {
 private:
-    int _source;
+    size_t _chunk_size;
+    T _value;
     T _bucket;
 
 public:
-    ibcast_reply(int _source, MPI_Comm _comm, const T &_value);
+    ialltoall_reply(MPI_Comm _comm, const T &_value, const size_t _chunk_size);
     auto get() -> T;
 };
-template <>
-class ibcast_reply<std::string> : public request
-{
-private:
-    int _source;
-    std::unique_ptr<char[]> _c_str;
-
-public:
-    ibcast_reply(int _source, MPI_Comm _comm, const std::string &_value);
-    auto get() -> std::string;
-};
 #pragma endregion
-#pragma region iscatter
+#pragma region variable counts
+//the requests own the counts and displacements, which have to stay alive until the operation is finished
 template <class T>
-class iscatter_request : public request
+class iallgatherv_request : public request
 {
 private:
-    int _source;
-    size_t _chunk_size;
+    impl::v_counts _counts;
     T _value;
-    T &_bucket;
 
 public:
-    iscatter_request(int _source, MPI_Comm _comm, const T &_value, T &_bucket, const size_t _chunk_size);
+    iallgatherv_request(MPI_Comm _comm, const T &_value, T &_bucket, impl::v_counts &&_counts);
 };
-template <>
-class iscatter_request<std::string> : public request
+template <class T>
+class ialltoallv_request : public request
 {
 private:
-    int _source;
-    size_t _chunk_size;
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
-    std::string &_bucket;
+    impl::v_counts _send_counts;
+    impl::v_counts _recv_counts;
+    T _value;
 
 public:
-    iscatter_request(int _source, MPI_Comm _comm, const std::string &_value, std::string &_bucket, const size_t _chunk_size);
-    virtual auto wait() -> void;
+    ialltoallv_request(MPI_Comm _comm, const T &_value, T &_bucket, impl::v_counts &&_send_counts, impl::v_counts &&_recv_counts);
 };
 template <class T>
-class iscatter_reply : public request
+class igatherv_request : public request
 {
 private:
-    int _source;
-    size_t _chunk_size;
+    int _dest;
+    impl::v_counts _counts;
     T _value;
-    T _bucket;
 
 public:
-    iscatter_reply(int _source, MPI_Comm _comm, const T &_value, const size_t _chunk_size);
-    auto get() -> T;
+    igatherv_request(int _dest, MPI_Comm _comm, const T &_value, T &_bucket, impl::v_counts &&_counts);
 };
-template <>
-class iscatter_reply<std::string> : public request
+template <class T>
+class iscatterv_request : public request
 {
 private:
     int _source;
-    size_t _chunk_size;
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
+    impl::v_counts _counts;
+    T _value;
 
 public:
-    iscatter_reply(int _source, MPI_Comm _comm, const std::string &_value, const size_t _chunk_size);
-    auto get() -> std::string;
+    iscatterv_request(int _source, MPI_Comm _comm, const T &_value, T &_bucket, impl::v_counts &&_counts, const size_t _chunk_size);
 };
 #pragma endregion
-#pragma region igather
+#pragma region ireduce
 template <class T>
-class igather_request : public request
+class ireduce_request : public request
 {
 private:
+    std::shared_ptr<op> _operation;
     int _dest;
     T _value;
     T &_bucket;
 
 public:
-    igather_request(int _dest, MPI_Comm _comm, const T &_value, T &_bucket);
+    ireduce_request(int _dest, MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation);
 };
-template <>
-class igather_request<std::string> : public request
+template <class T>
+class ireduce_reply : public request
 {
 private:
+    std::shared_ptr<op> _operation;
     int _dest;
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
-    std::string &_bucket;
+    T _value;
+    T _bucket;
 
 public:
-    igather_request(int _dest, MPI_Comm _comm, const std::string &_value, std::string &_bucket);
-    virtual auto wait() -> void;
+    ireduce_reply(int _dest, MPI_Comm _comm, const T &_value, std::shared_ptr<op> _operation);
+    auto get() -> T;
 };
+#pragma endregion
+#pragma region iallreduce
 template <class T>
-class igather_reply : public request
+class iallreduce_request : public request
 {
 private:
-    int _dest;
+    std::shared_ptr<op> _operation;
     T _value;
-    T _bucket;
+    T &_bucket;
 
 public:
-    igather_reply(int _dest, MPI_Comm _comm, const T &_value);
-    auto get() -> T;
+    iallreduce_request(MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation);
 };
-template <>
-class igather_reply<std::string> : public request
+template <class T>
+class iallreduce_reply : public request
 {
 private:
-    int _dest;
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
+    std::shared_ptr<op> _operation;
+    T _value;
+    T _bucket;
 
 public:
-    igather_reply(int _dest, MPI_Comm _comm, const std::string &_value);
-    auto get() -> std::string;
+    iallreduce_reply(MPI_Comm _comm, const T &_value, std::shared_ptr<op> _operation);
+    auto get() -> T;
 };
 #pragma endregion
-#pragma region iallgather
+#pragma region ineighbor collectives
 template <class T>
-class iallgather_request : public request
+class ineighbor_allgather_request : public request
 {
 private:
     T _value;
     T &_bucket;
 
 public:
-    iallgather_request(MPI_Comm _comm, const T &_value, T &_bucket);
+    ineighbor_allgather_request(MPI_Comm _comm, const T &_value, T &_bucket);
 };
-template <>
-class iallgather_request<std::string> : public request
+template <class T>
+class ineighbor_alltoall_request : public request
 {
 private:
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
-    std::string &_bucket;
+    size_t _chunk_size;
+    T _value;
+    T &_bucket;
 
 public:
-    iallgather_request(MPI_Comm _comm, const std::string &_value, std::string &_bucket);
-    virtual auto wait() -> void;
+    ineighbor_alltoall_request(MPI_Comm _comm, const T &_value, T &_bucket, const size_t _chunk_size);
 };
+#pragma endregion
+#pragma region iscan
 template <class T>
-class iallgather_reply : public request
+class iscan_request : public request
 {
 private:
+    std::shared_ptr<op> _operation;
     T _value;
-    T _bucket;
+    T &_bucket;
 
 public:
-    iallgather_reply(MPI_Comm _comm, const T &_value);
-    auto get() -> T;
+    iscan_request(MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation);
 };
-template <>
-class iallgather_reply<std::string> : public request
+template <class T>
+class iexscan_request : public request
 {
 private:
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
+    std::shared_ptr<op> _operation;
+    T _value;
+    T &_bucket;
+
+protected:
+    virtual auto complete() -> void;
 
 public:
-    iallgather_reply(MPI_Comm _comm, const std::string &_value);
-    auto get() -> std::string;
+    iexscan_request(MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation);
 };
 #pragma endregion
-#pragma region ialltoall
+#pragma region ireduce_scatter
 template <class T>
-class ialltoall_request : public request
+class ireduce_scatter_request : public request
 {
 private:
-    size_t _chunk_size;
+    std::shared_ptr<op> _operation;
+    impl::v_counts _counts;
     T _value;
-    T &_bucket;
 
 public:
-    ialltoall_request(MPI_Comm _comm, const T &_value, T &_bucket, const size_t _chunk_size);
+    ireduce_scatter_request(MPI_Comm _comm, const T &_value, T &_bucket, impl::v_counts &&_counts, std::shared_ptr<op> _operation);
 };
-template <>
-class ialltoall_request<std::string> : public request
+template <class T>
+class ireduce_scatter_block_request : public request
 {
 private:
-    size_t _chunk_size;
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
-    std::string &_bucket;
+    std::shared_ptr<op> _operation;
+    T _value;
 
 public:
-    ialltoall_request(MPI_Comm _comm, const std::string &_value, std::string &_bucket, const size_t _chunk_size);
-    virtual auto wait() -> void;
+    ireduce_scatter_block_request(MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation);
 };
-template <class T>
-class ialltoall_reply : public request
+#pragma endregion
+#pragma region persistent
+//persistent requests are set up once and restarted with start(), they are finished until they are started for the first time
+class persistent_request : public request
 {
+    friend auto startall(const std::vector<persistent_request *> &_values) -> void;
+
 private:
-    size_t _chunk_size;
-    T _value;
-    T _bucket;
+    //completes the previous round and resets the flags, returns true if MPI_Start still has to be called
+    auto restart() -> bool;
+
+protected:
+    persistent_request(MPI_Comm _comm);
+    virtual ~persistent_request();
+
+    //starts the request without MPI_Start, returns false if MPI_Start has to be used
+    virtual auto emulate_start() -> bool;
 
 public:
-    ialltoall_reply(MPI_Comm _comm, const T &_value, const size_t _chunk_size);
-    auto get() -> T;
+    //a request that is still active from the previous start is waited for first, so start blocks until that round is finished
+    auto start() -> void;
 };
-template <>
-class ialltoall_reply<std::string> : public request
+template <class T>
+class send_init_request : public persistent_request
 {
 private:
-    size_t _chunk_size;
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
+    int _dest;
+    int _tag;
+    const T &_value;
 
 public:
-    ialltoall_reply(MPI_Comm _comm, const std::string &_value, const size_t _chunk_size);
-    auto get() -> std::string;
+    send_init_request(int _dest, int _tag, MPI_Comm _comm, const T &_value);
 };
-#pragma endregion
-#pragma region ireduce
 template <class T>
-class ireduce_request : public request
+class ssend_init_request : public persistent_request
 {
 private:
-    std::shared_ptr<op> _operation;
     int _dest;
-    T _value;
-    T &_bucket;
+    int _tag;
+    const T &_value;
 
 public:
-    ireduce_request(int _dest, MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation);
+    ssend_init_request(int _dest, int _tag, MPI_Comm _comm, const T &_value);
 };
-template <>
-class ireduce_request<std::string> : public request
+template <class T>
+class rsend_init_request : public persistent_request
 {
 private:
-    std::shared_ptr<op> _operation;
     int _dest;
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
-    std::string &_bucket;
+    int _tag;
+    const T &_value;
 
 public:
-    ireduce_request(int _dest, MPI_Comm _comm, const std::string &_value, std::string &_bucket, std::shared_ptr<op> _operation);
-    virtual auto wait() -> void;
+    rsend_init_request(int _dest, int _tag, MPI_Comm _comm, const T &_value);
 };
 template <class T>
-class ireduce_reply : public request
+class recv_init_request : public persistent_request
 {
 private:
-    std::shared_ptr<op> _operation;
-    int _dest;
-    T _value;
-    T _bucket;
+    int _source;
+    int _tag;
+    bool is_posted = false;
+    T &_bucket;
+
+protected:
+    //a start must not block, so the receive is queued while an earlier nonblocking receive could still match its message
+    virtual auto emulate_start() -> bool;
+    virtual auto post(const bool _blocking) -> bool;
 
 public:
-    ireduce_reply(int _dest, MPI_Comm _comm, const T &_value, std::shared_ptr<op> _operation);
-    auto get() -> T;
+    recv_init_request(int _source, int _tag, MPI_Comm _comm, T &_value);
+    virtual auto cancel() -> void;
 };
-template <>
-class ireduce_reply<std::string> : public request
+namespace impl
+{
+//persistent collectives were added in MPI-4
+constexpr auto has_persistent_collectives = MPI_VERSION >= 4;
+} // namespace impl
+//collective plans use the persistent collectives of MPI-4, older libraries restart the nonblocking collective instead
+class persistent_collective_request : public persistent_request
+{
+protected:
+    persistent_collective_request(MPI_Comm _comm);
+    //active collective requests must not be freed
+    virtual ~persistent_collective_request();
+
+    virtual auto emulate_start() -> bool;
+    //either creates the persistent request or starts the nonblocking collective
+    virtual auto init() -> void = 0;
+};
+template <class T>
+class bcast_init_request : public persistent_collective_request
 {
 private:
-    std::shared_ptr<op> _operation;
-    int _dest;
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
+    int _source;
+    T &_value;
+
+protected:
+    virtual auto init() -> void;
 
 public:
-    ireduce_reply(int _dest, MPI_Comm _comm, const std::string &_value, std::shared_ptr<op> _operation);
-    auto get() -> std::string;
+    bcast_init_request(int _source, MPI_Comm _comm, T &_value);
 };
-#pragma endregion
-#pragma region iallreduce
 template <class T>
-class iallreduce_request : public request
+class allgather_init_request : public persistent_collective_request
 {
 private:
-    std::shared_ptr<op> _operation;
-    T _value;
-    T &_bucket;
+    const T &_value;
+    std::vector<T> &_bucket;
+
+protected:
+    virtual auto init() -> void;
 
 public:
-    iallreduce_request(MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation);
+    allgather_init_request(MPI_Comm _comm, const T &_value, std::vector<T> &_bucket);
 };
-template <>
-class iallreduce_request<std::string> : public request
+template <class T>
+class allgather_init_request<std::vector<T>> : public persistent_collective_request
 {
 private:
-    std::shared_ptr<op> _operation;
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
-    std::string &_bucket;
+    const std::vector<T> &_value;
+    std::vector<T> &_bucket;
+
+protected:
+    virtual auto init() -> void;
 
 public:
-    iallreduce_request(MPI_Comm _comm, const std::string &_value, std::string &_bucket, std::shared_ptr<op> _operation);
-    virtual auto wait() -> void;
+    allgather_init_request(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket);
 };
 template <class T>
-class iallreduce_reply : public request
+class alltoall_init_request : public persistent_collective_request
 {
 private:
-    std::shared_ptr<op> _operation;
-    T _value;
-    T _bucket;
+    size_t _chunk_size;
+    const T &_value;
+    T &_bucket;
+
+protected:
+    virtual auto init() -> void;
 
 public:
-    iallreduce_reply(MPI_Comm _comm, const T &_value, std::shared_ptr<op> _operation);
-    auto get() -> T;
+    alltoall_init_request(MPI_Comm _comm, const T &_value, T &_bucket, const size_t _chunk_size);
 };
-template <>
-class iallreduce_reply<std::string> : public request
+template <class T>
+class allreduce_init_request : public persistent_collective_request
 {
 private:
     std::shared_ptr<op> _operation;
-    std::string _value;
-    std::unique_ptr<char[]> _c_str;
+    const T &_value;
+    T &_bucket;
+
+protected:
+    virtual auto init() -> void;
 
 public:
-    iallreduce_reply(MPI_Comm _comm, const std::string &_value, std::shared_ptr<op> _operation);
-    auto get() -> std::string;
+    allreduce_init_request(MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation);
 };
 #pragma endregion
 #pragma endregion
+#pragma region start
+//like start, every request that is still active is waited for before the new round begins
+auto startall(const std::vector<std::unique_ptr<persistent_request>> &_values) -> void;
+template <class... T>
+auto startall(std::unique_ptr<T> &... _values) -> void;
+template <class... T>
+auto startall(T *... _values) -> void;
+#pragma endregion
 #pragma region test
 auto test(request *_value) -> bool;
 auto test(std::unique_ptr<request> &_value) -> bool;
@@ -886,6 +2075,62 @@ auto waitsome(std::unique_ptr<T> &... _values) -> std::vector<size_t>;
 template <class... T>
 auto waitsome(T *... _values) -> std::vector<size_t>;
 #pragma endregion
+#pragma region request set
+//owns the handles of many requests in one contiguous array, the requests work on their slot in it,
+//so testing and waiting neither copies handles nor allocates after the first call, and only touches the finished requests,
+//a request belongs to at most one set, it gets its handle back when the set is cleared or destroyed
+class request_set
+{
+    friend class request;
+
+private:
+    std::vector<request *> _values;
+    std::vector<MPI_Request> _requests;
+    std::vector<MPI_Status> _statuses;
+    std::vector<int> _indexes;
+    std::vector<size_t> _completed;
+
+    //points the requests to their slots, needed whenever the storage moved
+    auto bind() -> void;
+    //hands the handles back to the requests
+    auto release() -> void;
+    //called by a request that is destroyed while it is still in the set
+    auto detach(size_t _index) -> void;
+    //posts requests which are still waiting for their message, returns false if some of them cannot be posted yet
+    auto refresh(const bool _blocking) -> bool;
+    auto finish(size_t _index, const MPI_Status &_status) -> void;
+
+public:
+    static constexpr auto npos = static_cast<size_t>(-1);
+
+    request_set() = default;
+    request_set(const request_set &) = delete;
+    request_set(request_set &&_other);
+    request_set &operator=(const request_set &) = delete;
+    request_set &operator=(request_set &&_other);
+    ~request_set();
+
+    auto add(request *_value) -> size_t;
+    template <class T>
+    auto add(std::unique_ptr<T> &_value) -> size_t;
+    auto reserve(size_t _size) -> void;
+    auto clear() -> void;
+    auto size() const -> size_t;
+    auto operator[](size_t _index) const -> request *;
+
+    auto testall() -> bool;
+    //returns the index of the finished request, or npos
+    auto testany() -> size_t;
+    //the returned indexes stay valid until the next call
+    auto testsome() -> const std::vector<size_t> &;
+
+    auto waitall() -> void;
+    //returns the index of the finished request, or npos if no request was active
+    auto waitany() -> size_t;
+    //the returned indexes stay valid until the next call
+    auto waitsome() -> const std::vector<size_t> &;
+};
+#pragma endregion
 #pragma region sender_receiver
 class sender_receiver
 {
@@ -902,6 +2147,8 @@ public:
 
     auto operator==(const sender_receiver &rhs) -> bool;
     auto operator!=(const sender_receiver &rhs) -> bool;
+    //handles are values, the arrow keeps the pointer-like call syntax working
+    auto operator->() -> sender_receiver *;
 
 #pragma region sendrecv
     template <class T, class U>
@@ -914,6 +2161,8 @@ public:
     auto sendrecv(const char *_value, T &_bucket) -> void;
     template <class T>
     auto sendrecv(const std::string &_value, T &_bucket) -> void;
+    template <class T, class U>
+    auto sendrecv(view<U> _value, view<T> _bucket) -> void;
 
     template <class T, class U>
     auto sendrecv(const U &_value) -> T;
@@ -947,24 +2196,43 @@ public:
 
     auto operator==(const receiver &rhs) -> bool;
     auto operator!=(const receiver &rhs) -> bool;
+    //handles are values, the arrow keeps the pointer-like call syntax working
+    auto operator->() -> receiver *;
 
-    auto dest(int _dest) -> std::unique_ptr<sender_receiver>;
+    auto dest(int _dest, int _tag = 0) -> sender_receiver;
 
 #pragma region recv
     template <class T>
     auto recv(T &_value) -> void;
     template <class T>
+    auto recv(view<T> _value) -> void;
+    template <class T>
     auto recv() -> T;
 #pragma endregion
 #pragma region irecv
     template <class T>
     auto irecv(T &_value) -> std::unique_ptr<irecv_request<T>>;
     template <class T>
+    auto irecv(view<T> _value) -> std::unique_ptr<irecv_request<view<T>>>;
+    template <class T>
     auto irecv() -> std::unique_ptr<irecv_reply<T>>;
 #pragma endregion
+#pragma region recv_init
+    template <class T>
+    auto recv_init(T &_value) -> std::unique_ptr<recv_init_request<T>>;
+#pragma endregion
+#pragma region bcast_init
+    template <class T>
+    auto bcast_init(T &_value) -> std::unique_ptr<bcast_init_request<T>>;
+#pragma endregion
 #pragma region bcast
     template <class T>
     auto bcast(T &_value) -> void;
+    template <class T>
+    auto bcast(T &_value, hierarchy _mode) -> void;
+    //views always run flat
+    template <class T>
+    auto bcast(view<T> _value) -> void;
     template <class R, class T>
     auto bcast(const T &_value) -> std::enable_if_t<std::is_same<R, T>::value, T>;
     template <class R, class T>
@@ -990,6 +2258,11 @@ public:
     template <class R>
     auto ibcast(const std::string &_value) -> std::enable_if_t<std::is_same<R, std::string>::value, std::unique_ptr<ibcast_reply<std::string>>>;
 #pragma endregion
+#pragma region share
+    //the root's data ends up once in every shared memory node
+    template <class T>
+    auto share(const std::vector<T> &_value) -> shared_array<T>;
+#pragma endregion
 #pragma region scatter
     template <class T>
     auto scatter(const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void;
@@ -1010,6 +2283,19 @@ public:
     auto iscatter(const char *_value, const size_t _chunk_size) -> std::unique_ptr<iscatter_reply<std::string>>;
     auto iscatter(const std::string &_value, const size_t _chunk_size) -> std::unique_ptr<iscatter_reply<std::string>>;
 #pragma endregion
+#pragma region scatterv
+    //_counts is only read at the root, the other processes get their count first unless they pass _chunk_size
+    template <class T>
+    auto scatterv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> void;
+    template <class T>
+    auto scatterv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, const size_t _chunk_size) -> void;
+    template <class T>
+    auto scatterv(const std::vector<T> &_value, const std::vector<size_t> &_counts) -> std::vector<T>;
+    template <class T>
+    auto iscatterv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> std::unique_ptr<iscatterv_request<std::vector<T>>>;
+    template <class T>
+    auto iscatterv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, const size_t _chunk_size) -> std::unique_ptr<iscatterv_request<std::vector<T>>>;
+#pragma endregion
 };
 #pragma endregion
 #pragma region sender
@@ -1025,14 +2311,18 @@ public:
 
     auto operator==(const sender &rhs) -> bool;
     auto operator!=(const sender &rhs) -> bool;
+    //handles are values, the arrow keeps the pointer-like call syntax working
+    auto operator->() -> sender *;
 
-    auto source(int _source) -> std::unique_ptr<sender_receiver>;
+    auto source(int _source, int _tag = 0) -> sender_receiver;
 
 #pragma region send
     template <class T>
     auto send(const T &_value) -> void;
     template <class T>
     auto send(const std::vector<T> &_value) -> void;
+    template <class T>
+    auto send(view<T> _value) -> void;
     auto send(const char _value) -> void;
     auto send(const char *_value) -> void;
     auto send(const std::string &_value) -> void;
@@ -1046,6 +2336,13 @@ public:
     auto isend(const char *_value) -> std::unique_ptr<isend_request<std::string>>;
     auto isend(const std::string &_value) -> std::unique_ptr<isend_request<std::string>>;
     template <class T>
+    auto isend(std::vector<T> &&_value) -> std::unique_ptr<isend_request<std::vector<T>>>;
+    auto isend(std::string &&_value) -> std::unique_ptr<isend_request<std::string>>;
+    template <class T>
+    auto isend(borrowed<T> _value) -> std::unique_ptr<isend_request<borrowed<T>>>;
+    template <class T>
+    auto isend(view<T> _value) -> std::unique_ptr<isend_request<view<T>>>;
+    template <class T>
     auto issend(const T &_value) -> std::unique_ptr<issend_request<T>>;
 #pragma endregion
 #pragma region ssend
@@ -1064,9 +2361,16 @@ public:
     auto issend(const char *_value) -> std::unique_ptr<issend_request<std::string>>;
     auto issend(const std::string &_value) -> std::unique_ptr<issend_request<std::string>>;
     template <class T>
+    auto issend(std::vector<T> &&_value) -> std::unique_ptr<issend_request<std::vector<T>>>;
+    auto issend(std::string &&_value) -> std::unique_ptr<issend_request<std::string>>;
+    template <class T>
+    auto issend(borrowed<T> _value) -> std::unique_ptr<issend_request<borrowed<T>>>;
+    template <class T>
     auto irsend(const T &_value) -> std::unique_ptr<irsend_request<T>>;
 #pragma endregion
 #pragma region rsend
+    //ready mode needs the matching receive to be posted already, irecv of vectors and strings only posts once the message was probed,
+    //so the receiver has to use a fixed-size bucket or a view for rsend, irsend and rsend_init
     template <class T>
     auto rsend(const T &_value) -> void;
     template <class T>
@@ -1081,12 +2385,27 @@ public:
     auto irsend(const char _value) -> std::unique_ptr<irsend_request<std::string>>;
     auto irsend(const char *_value) -> std::unique_ptr<irsend_request<std::string>>;
     auto irsend(const std::string &_value) -> std::unique_ptr<irsend_request<std::string>>;
+    template <class T>
+    auto irsend(std::vector<T> &&_value) -> std::unique_ptr<irsend_request<std::vector<T>>>;
+    auto irsend(std::string &&_value) -> std::unique_ptr<irsend_request<std::string>>;
+    template <class T>
+    auto irsend(borrowed<T> _value) -> std::unique_ptr<irsend_request<borrowed<T>>>;
+#pragma endregion
+#pragma region send_init
+    template <class T>
+    auto send_init(const T &_value) -> std::unique_ptr<send_init_request<T>>;
+    template <class T>
+    auto ssend_init(const T &_value) -> std::unique_ptr<ssend_init_request<T>>;
+    template <class T>
+    auto rsend_init(const T &_value) -> std::unique_ptr<rsend_init_request<T>>;
 #pragma endregion
 #pragma region gather
     template <class T>
     auto gather(const T &_value, std::vector<T> &_bucket) -> void;
     template <class T>
     auto gather(const std::vector<T> &_value, std::vector<T> &_bucket) -> void;
+    template <class T>
+    auto gather(view<T> _value, std::vector<T> &_bucket) -> void;
     auto gather(const char _value, std::string &_bucket) -> void;
     auto gather(const char *_value, std::string &_bucket) -> void;
     auto gather(const std::string &_value, std::string &_bucket) -> void;
@@ -1114,11 +2433,28 @@ public:
     auto igather(const char *_value) -> std::unique_ptr<igather_reply<std::string>>;
     auto igather(const std::string &_value) -> std::unique_ptr<igather_reply<std::string>>;
 #pragma endregion
+#pragma region gatherv
+    //without counts they are gathered first, with counts only the root has to pass them
+    template <class T>
+    auto gatherv(const std::vector<T> &_value, std::vector<T> &_bucket) -> void;
+    template <class T>
+    auto gatherv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> void;
+    template <class T>
+    auto gatherv(const std::vector<T> &_value) -> std::vector<T>;
+    template <class T>
+    auto igatherv(const std::vector<T> &_value, std::vector<T> &_bucket) -> std::unique_ptr<igatherv_request<std::vector<T>>>;
+    template <class T>
+    auto igatherv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> std::unique_ptr<igatherv_request<std::vector<T>>>;
+#pragma endregion
 #pragma region reduce
     template <class T>
     auto reduce(const T &_value, T &_bucket, op *_operation) -> void;
     template <class T>
     auto reduce(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void;
+    template <class T>
+    auto reduce(const T &_value, T &_bucket, op *_operation, hierarchy _mode) -> void;
+    template <class T>
+    auto reduce(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation, hierarchy _mode) -> void;
     auto reduce(const char _value, std::string &_bucket, op *_operation) -> void;
     auto reduce(const char *_value, std::string &_bucket, op *_operation) -> void;
     auto reduce(const std::string &_value, std::string &_bucket, op *_operation) -> void;
@@ -1134,6 +2470,10 @@ public:
     auto reduce(const T &_value, T &_bucket, Op _operation) -> void;
     template <class T, class Op>
     auto reduce(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> void;
+    template <class T, class Op>
+    auto reduce(const T &_value, T &_bucket, Op _operation, hierarchy _mode) -> void;
+    template <class T, class Op>
+    auto reduce(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation, hierarchy _mode) -> void;
     template <class Op>
     auto reduce(const char _value, std::string &_bucket, Op _operation) -> void;
     template <class Op>
@@ -1,11 +1,378 @@
 #pragma once
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
+#include <initializer_list>
+#include <map>
+#include <utility>
 #include <mpiwrap/impl/lambda_hack.h>
 
 namespace mpi
 {
+#pragma region derived types
+namespace impl
+{
+template <class... T>
+struct make_void
+{
+    using type = void;
+};
+template <class T, class = void>
+struct is_described : std::false_type
+{
+};
+template <class T>
+struct is_described<T, typename make_void<decltype(describe<T>::members())>::type> : std::true_type
+{
+};
+//arrays become one block of their elements
+template <class T, class C, class M>
+auto add_member(const T *_object, M C::*_member, MPI_Aint _base, std::vector<int> &_lengths, std::vector<MPI_Aint> &_displacements, std::vector<MPI_Datatype> &_types) -> void
+{
+    using E = std::remove_all_extents_t<M>;
+    auto _address = MPI_Aint{};
+    MPI_Get_address(&(_object->*_member), &_address);
+    _lengths.push_back(static_cast<int>(sizeof(M) / sizeof(E)));
+    _displacements.push_back(_address - _base);
+    _types.push_back(type_wrapper<E>{});
+}
+template <class T, class Tuple, size_t... I>
+auto build_struct(const Tuple &_members, std::index_sequence<I...>) -> MPI_Datatype
+{
+    //the addresses are only taken, the object is never constructed
+    auto _storage = std::aligned_storage_t<sizeof(T), alignof(T)>{};
+    auto _object = reinterpret_cast<const T *>(&_storage);
+    auto _base = MPI_Aint{};
+    MPI_Get_address(_object, &_base);
+    auto _lengths = std::vector<int>{};
+    auto _displacements = std::vector<MPI_Aint>{};
+    auto _types = std::vector<MPI_Datatype>{};
+    auto _expand = {(add_member(_object, std::get<I>(_members), _base, _lengths, _displacements, _types), 0)...};
+    (void)_expand;
+    auto _struct = MPI_Datatype{};
+    MPI_Type_create_struct(static_cast<int>(_types.size()), _lengths.data(), _displacements.data(), _types.data(), &_struct);
+    //the trailing padding belongs to the extent, otherwise vectors of T are misaligned
+    auto _type = MPI_Datatype{};
+    MPI_Type_create_resized(_struct, 0, sizeof(T), &_type);
+    MPI_Type_free(&_struct);
+    return _type;
+}
+template <class T>
+auto build_type(std::true_type) -> MPI_Datatype
+{
+    auto _members = describe<T>::members();
+    return build_struct<T>(_members, std::make_index_sequence<std::tuple_size<decltype(_members)>::value>{});
+}
+//tuples and pairs of scalars become struct types as well, their layout is taken from a value-initialized instance
+template <class T>
+struct is_tuple : std::false_type
+{
+};
+template <class... T>
+struct is_tuple<std::tuple<T...>> : std::true_type
+{
+};
+template <class A, class B>
+struct is_tuple<std::pair<A, B>> : std::true_type
+{
+};
+struct tuple_tag
+{
+};
+template <class E>
+auto add_element(const E *_element, MPI_Aint _base, std::vector<int> &_lengths, std::vector<MPI_Aint> &_displacements, std::vector<MPI_Datatype> &_types) -> void
+{
+    auto _address = MPI_Aint{};
+    MPI_Get_address(_element, &_address);
+    _lengths.push_back(1);
+    _displacements.push_back(_address - _base);
+    _types.push_back(type_wrapper<E>{});
+}
+template <class T, size_t... I>
+auto build_tuple(std::index_sequence<I...>) -> MPI_Datatype
+{
+    auto _object = T{};
+    auto _base = MPI_Aint{};
+    MPI_Get_address(&_object, &_base);
+    auto _lengths = std::vector<int>{};
+    auto _displacements = std::vector<MPI_Aint>{};
+    auto _types = std::vector<MPI_Datatype>{};
+    auto _expand = {(add_element(&std::get<I>(_object), _base, _lengths, _displacements, _types), 0)...};
+    (void)_expand;
+    auto _struct = MPI_Datatype{};
+    MPI_Type_create_struct(static_cast<int>(_types.size()), _lengths.data(), _displacements.data(), _types.data(), &_struct);
+    auto _type = MPI_Datatype{};
+    MPI_Type_create_resized(_struct, 0, sizeof(T), &_type);
+    MPI_Type_free(&_struct);
+    return _type;
+}
+template <class T>
+auto build_type(tuple_tag) -> MPI_Datatype
+{
+    return build_tuple<T>(std::make_index_sequence<std::tuple_size<T>::value>{});
+}
+template <class T>
+auto build_type(std::false_type) -> MPI_Datatype
+{
+    static_assert(std::is_trivially_copyable<T>::value, "types without a builtin datatype have to be trivially copyable or described");
+    auto _type = MPI_Datatype{};
+    MPI_Type_contiguous(static_cast<int>(sizeof(T)), MPI_BYTE, &_type);
+    return _type;
+}
+template <class T>
+auto derived_type() -> MPI_Datatype
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //MPI releases the committed types in MPI_Finalize
+    static auto _type = [] {
+        auto _type = build_type<T>(std::conditional_t<is_tuple<T>::value, tuple_tag, is_described<T>>{});
+        MPI_Type_commit(&_type);
+        return _type;
+    }();
+    return _type;
+}
+} // namespace impl
+#pragma endregion
+#pragma region serialization
+namespace impl
+{
+//declarations, all overloads have to be visible before the templates call each other for nested containers
+auto serialize(std::vector<char> &_buffer, const std::string &_value) -> void;
+auto deserialize(const char *&_position, std::string &_value) -> void;
+template <class T>
+auto serialize(std::vector<char> &_buffer, const T &_value) -> void;
+template <class T>
+auto deserialize(const char *&_position, T &_value) -> void;
+template <class T, class U>
+auto serialize(std::vector<char> &_buffer, const std::pair<T, U> &_value) -> void;
+template <class T, class U>
+auto deserialize(const char *&_position, std::pair<T, U> &_value) -> void;
+template <class... T>
+auto serialize(std::vector<char> &_buffer, const std::tuple<T...> &_value) -> void;
+template <class... T>
+auto deserialize(const char *&_position, std::tuple<T...> &_value) -> void;
+template <class T, class A>
+auto serialize(std::vector<char> &_buffer, const std::vector<T, A> &_value) -> void;
+template <class T, class A>
+auto deserialize(const char *&_position, std::vector<T, A> &_value) -> void;
+template <class K, class V, class C, class A>
+auto serialize(std::vector<char> &_buffer, const std::map<K, V, C, A> &_value) -> void;
+template <class K, class V, class C, class A>
+auto deserialize(const char *&_position, std::map<K, V, C, A> &_value) -> void;
+template <class K, class V, class H, class E, class A>
+auto serialize(std::vector<char> &_buffer, const std::unordered_map<K, V, H, E, A> &_value) -> void;
+template <class K, class V, class H, class E, class A>
+auto deserialize(const char *&_position, std::unordered_map<K, V, H, E, A> &_value) -> void;
+template <class K, class C, class A>
+auto serialize(std::vector<char> &_buffer, const std::set<K, C, A> &_value) -> void;
+template <class K, class C, class A>
+auto deserialize(const char *&_position, std::set<K, C, A> &_value) -> void;
+//templates
+//everything else has to be trivially copyable and is copied as it is
+template <class T>
+auto serialize(std::vector<char> &_buffer, const T &_value) -> void
+{
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable types and the standard containers can be serialized");
+    auto _bytes = reinterpret_cast<const char *>(&_value);
+    _buffer.insert(_buffer.end(), _bytes, _bytes + sizeof(T));
+}
+template <class T>
+auto deserialize(const char *&_position, T &_value) -> void
+{
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable types and the standard containers can be deserialized");
+    std::memcpy(&_value, _position, sizeof(T));
+    _position += sizeof(T);
+}
+template <class T, class U>
+auto serialize(std::vector<char> &_buffer, const std::pair<T, U> &_value) -> void
+{
+    serialize(_buffer, _value.first);
+    serialize(_buffer, _value.second);
+}
+template <class T, class U>
+auto deserialize(const char *&_position, std::pair<T, U> &_value) -> void
+{
+    deserialize(_position, _value.first);
+    deserialize(_position, _value.second);
+}
+template <class... T, size_t... I>
+auto serialize(std::vector<char> &_buffer, const std::tuple<T...> &_value, std::index_sequence<I...>) -> void
+{
+    auto _expand = {(serialize(_buffer, std::get<I>(_value)), 0)...};
+    (void)_expand;
+}
+template <class... T>
+auto serialize(std::vector<char> &_buffer, const std::tuple<T...> &_value) -> void
+{
+    serialize(_buffer, _value, std::index_sequence_for<T...>{});
+}
+template <class... T, size_t... I>
+auto deserialize(const char *&_position, std::tuple<T...> &_value, std::index_sequence<I...>) -> void
+{
+    auto _expand = {(deserialize(_position, std::get<I>(_value)), 0)...};
+    (void)_expand;
+}
+template <class... T>
+auto deserialize(const char *&_position, std::tuple<T...> &_value) -> void
+{
+    deserialize(_position, _value, std::index_sequence_for<T...>{});
+}
+//trivial elements are copied as one block
+template <class T, class A>
+auto serialize_elements(std::vector<char> &_buffer, const std::vector<T, A> &_value, std::true_type) -> void
+{
+    auto _bytes = reinterpret_cast<const char *>(_value.data());
+    _buffer.insert(_buffer.end(), _bytes, _bytes + _value.size() * sizeof(T));
+}
+template <class T, class A>
+auto serialize_elements(std::vector<char> &_buffer, const std::vector<T, A> &_value, std::false_type) -> void
+{
+    for (auto &&_element : _value)
+        serialize(_buffer, _element);
+}
+template <class T, class A>
+auto deserialize_elements(const char *&_position, std::vector<T, A> &_value, std::true_type) -> void
+{
+    std::memcpy(_value.data(), _position, _value.size() * sizeof(T));
+    _position += _value.size() * sizeof(T);
+}
+template <class T, class A>
+auto deserialize_elements(const char *&_position, std::vector<T, A> &_value, std::false_type) -> void
+{
+    for (auto &_element : _value)
+        deserialize(_position, _element);
+}
+//containers write their element count first
+template <class T, class A>
+auto serialize(std::vector<char> &_buffer, const std::vector<T, A> &_value) -> void
+{
+    serialize(_buffer, static_cast<std::uint64_t>(_value.size()));
+    serialize_elements(_buffer, _value, std::is_trivially_copyable<T>{});
+}
+template <class T, class A>
+auto deserialize(const char *&_position, std::vector<T, A> &_value) -> void
+{
+    auto _size = std::uint64_t{};
+    deserialize(_position, _size);
+    _value.resize(_size);
+    deserialize_elements(_position, _value, std::is_trivially_copyable<T>{});
+}
+template <class K, class V, class C, class A>
+auto serialize(std::vector<char> &_buffer, const std::map<K, V, C, A> &_value) -> void
+{
+    serialize(_buffer, static_cast<std::uint64_t>(_value.size()));
+    for (auto &&_element : _value)
+    {
+        serialize(_buffer, _element.first);
+        serialize(_buffer, _element.second);
+    }
+}
+template <class K, class V, class C, class A>
+auto deserialize(const char *&_position, std::map<K, V, C, A> &_value) -> void
+{
+    auto _size = std::uint64_t{};
+    deserialize(_position, _size);
+    _value.clear();
+    for (auto i = std::uint64_t{}; i < _size; i++)
+    {
+        auto _key = K{};
+        auto _mapped = V{};
+        deserialize(_position, _key);
+        deserialize(_position, _mapped);
+        //the keys arrive sorted
+        _value.emplace_hint(_value.end(), std::move(_key), std::move(_mapped));
+    }
+}
+template <class K, class V, class H, class E, class A>
+auto serialize(std::vector<char> &_buffer, const std::unordered_map<K, V, H, E, A> &_value) -> void
+{
+    serialize(_buffer, static_cast<std::uint64_t>(_value.size()));
+    for (auto &&_element : _value)
+    {
+        serialize(_buffer, _element.first);
+        serialize(_buffer, _element.second);
+    }
+}
+template <class K, class V, class H, class E, class A>
+auto deserialize(const char *&_position, std::unordered_map<K, V, H, E, A> &_value) -> void
+{
+    auto _size = std::uint64_t{};
+    deserialize(_position, _size);
+    _value.clear();
+    _value.reserve(_size);
+    for (auto i = std::uint64_t{}; i < _size; i++)
+    {
+        auto _key = K{};
+        auto _mapped = V{};
+        deserialize(_position, _key);
+        deserialize(_position, _mapped);
+        _value.emplace(std::move(_key), std::move(_mapped));
+    }
+}
+template <class K, class C, class A>
+auto serialize(std::vector<char> &_buffer, const std::set<K, C, A> &_value) -> void
+{
+    serialize(_buffer, static_cast<std::uint64_t>(_value.size()));
+    for (auto &&_element : _value)
+        serialize(_buffer, _element);
+}
+template <class K, class C, class A>
+auto deserialize(const char *&_position, std::set<K, C, A> &_value) -> void
+{
+    auto _size = std::uint64_t{};
+    deserialize(_position, _size);
+    _value.clear();
+    for (auto i = std::uint64_t{}; i < _size; i++)
+    {
+        auto _key = K{};
+        deserialize(_position, _key);
+        _value.emplace_hint(_value.end(), std::move(_key));
+    }
+}
+template <class T>
+packed::packed(const T &_value) : _buffer(arena_acquire())
+{
+    serialize(this->_buffer, _value);
+}
+template <class T>
+auto packed::unpack(T &_value) const -> void
+{
+    auto _position = static_cast<const char *>(this->_buffer.data());
+    deserialize(_position, _value);
+}
+//requests which only sometimes receive packed unpack through these
+template <class T>
+auto unpack(const packed &_packed, T &_value, std::true_type) -> void
+{
+    _packed.unpack(_value);
+}
+template <class T>
+auto unpack(const packed &, T &, std::false_type) -> void
+{
+}
+//messages of packed values
+auto send_packed(int _dest, int _tag, MPI_Comm _comm, const packed &_value) -> void;
+auto recv_packed(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status) -> packed;
+template <class T>
+auto bcast_packed(int _source, MPI_Comm _comm, T &_value) -> void
+{
+    //get current rank
+    auto _rank = impl::rank(_comm);
+    auto _packed = (_rank == _source) ? packed{_value} : packed{};
+    //broadcast the size before the bytes
+    auto _size = static_cast<std::uint64_t>(_packed.size());
+    MPI_Bcast(&_size, 1, MPI_UINT64_T, _source, _comm);
+    if (_rank != _source)
+        _packed.resize(_size);
+    auto _count = large_count{_size, MPI_BYTE};
+    MPIWRAP_LARGE(MPI_Bcast)(_packed.data(), _count.count(), _count.type(), _source, _comm);
+    if (_rank != _source)
+        _packed.unpack(_value);
+}
+} // namespace impl
+#pragma endregion
 #pragma region allgather
 //declarations
 auto allgather_impl(MPI_Comm _comm, const std::string &_value, std::string &_bucket) -> void;
@@ -15,20 +382,35 @@ auto allgather_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T>
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
     //get world size
-    auto _size = comm(_comm)->size();
-    //broadcast the chunk_size before the data is gathered
-    auto _chunk_size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_chunk_size);
-    //check size
-    assert((_value.size() == _chunk_size));
+    auto _size = impl::size(_comm);
+    //check the chunk_size against the root before the data is gathered
+    auto _chunk_size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _chunk_size);
     //resize bucket to take all elements
     if (_size * _chunk_size != _bucket.size())
         _bucket.resize(_size * _chunk_size);
     //gather the data
-    MPI_Allgather(_value.data(), _chunk_size, type_wrapper<T>{}, _bucket.data(), _chunk_size, type_wrapper<T>{}, _comm);
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Allgather)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm);
+}
+template <class T>
+auto allgather_impl(MPI_Comm _comm, const view<T> &_value, std::vector<T> &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //get world size
+    auto _size = static_cast<size_t>(impl::size(_comm));
+    //every view has to cover the same number of elements
+    auto _chunk_size = static_cast<size_t>(_value.size());
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _chunk_size);
+    //resize bucket to take all elements
+    if (_size * _chunk_size != _bucket.size())
+        _bucket.resize(_size * _chunk_size);
+    //the view is sent as one element of its type and received as plain elements
+    MPI_Allgather(_value.data(), 1, _value.type(), _bucket.data(), _value.size(), type_wrapper<T>{}, _comm);
 }
 #pragma endregion
 #pragma region allreduce
@@ -41,25 +423,26 @@ auto allreduce_impl(MPI_Comm _comm, const T &_value, T &_bucket, op *_operation)
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     //reduce the data
-    MPI_Reduce(&_value, &_bucket, 1, type_wrapper<T>{}, _operation->get(), _comm);
+    MPI_Allreduce(&_value, &_bucket, 1, _operation->type(type_wrapper<T>{}), _operation->get(), _comm);
 }
 template <class T>
 auto allreduce_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the chunk_size before the data is reduced
-    auto _size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
+    //check the chunk_size against the root before the data is reduced
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
     //resize bucket to take all elements
     if (_size != _bucket.size())
         _bucket.resize(_size);
-    //reduce the data
-    MPI_Allreduce(_value.data(), _bucket.data(), _size, type_wrapper<T>{}, _operation->get(), _comm);
+    //reduce the data, derived types do not work with builtin operations, so large buffers are reduced in chunks
+    for (auto _offset = size_t{}; _offset < _size; _offset += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_size - _offset, impl::max_count));
+        MPIWRAP_LARGE(MPI_Allreduce)(_value.data() + _offset, _bucket.data() + _offset, _count, _operation->type(type_wrapper<T>{}), _operation->get(), _comm);
+    }
 }
 #pragma endregion
 #pragma region alltoall
@@ -71,48 +454,70 @@ auto alltoall_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T>
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the size before the data is gathered
-    auto _size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
+    //check the size against the root before the data is gathered
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
     //double check size
-    assert((_size >= _chunk_size * comm(_comm)->size()));
+    assert((_size >= _chunk_size * impl::size(_comm)));
     //resize bucket to take all elements
     if (_size != _bucket.size())
         _bucket.resize(_size);
     //gather the data
-    MPI_Alltoall(_value.data(), _chunk_size, type_wrapper<T>{}, _bucket.data(), _chunk_size, type_wrapper<T>{}, _comm);
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Alltoall)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm);
 }
 #pragma endregion
 #pragma region broadcast
 //declarations
 auto bcast_impl(int _source, MPI_Comm _comm, std::string &_value) -> void;
 //templates
+//maps, sets and vectors of non-trivial elements are broadcast packed
 template <class T>
-auto bcast_impl(int _source, MPI_Comm _comm, T &_value) -> void
+auto bcast_impl(int _source, MPI_Comm _comm, T &_value, std::true_type) -> void
+{
+    impl::bcast_packed(_source, _comm, _value);
+}
+template <class T>
+auto bcast_impl(int _source, MPI_Comm _comm, T &_value, std::false_type) -> void
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
     MPI_Bcast(&_value, 1, type_wrapper<T>{}, _source, _comm);
 }
 template <class T>
-auto bcast_impl(int _source, MPI_Comm _comm, std::vector<T> &_value) -> void
+auto bcast_impl(int _source, MPI_Comm _comm, std::vector<T> &_value, std::false_type) -> void
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
     //get current rank
-    auto _rank = comm(_comm)->rank();
+    auto _rank = impl::rank(_comm);
     //broadcast the size before the data
-    auto _size = (_rank == _source) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(_source)->bcast(_size);
+    auto _size = (_rank == _source) ? static_cast<std::uint64_t>(_value.size()) : std::uint64_t{};
+    MPI_Bcast(&_size, 1, MPI_UINT64_T, _source, _comm);
     //resize the vector if not the sender
     if (_rank != _source)
         _value.resize(_size);
     //broadcast the data
-    MPI_Bcast(_value.data(), _size, type_wrapper<T>{}, _source, _comm);
+    auto _count = impl::large_count{_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Bcast)(_value.data(), _count.count(), _count.type(), _source, _comm);
+}
+template <class T>
+auto bcast_impl(int _source, MPI_Comm _comm, T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    bcast_impl(_source, _comm, _value, impl::is_serialized<T>{});
+}
+template <class T>
+auto bcast_impl(int _source, MPI_Comm _comm, std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    bcast_impl(_source, _comm, _value, impl::is_serialized<std::vector<T>>{});
+}
+template <class T>
+auto bcast_impl(int _source, MPI_Comm _comm, view<T> _value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Bcast(_value.data(), 1, _value.type(), _source, _comm);
 }
 #pragma endregion
 #pragma region gather
@@ -125,14 +530,13 @@ auto gather_impl(int _dest, MPI_Comm _comm, const std::vector<T> &_value, std::v
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     //get current rank
-    auto _rank = comm(_comm)->rank();
+    auto _rank = impl::rank(_comm);
     //get world size
-    auto _size = comm(_comm)->size();
-    //broadcast the chunk_size before the data is gathered
-    auto _chunk_size = (_rank == _dest) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(_dest)->bcast(_chunk_size);
-    //check size
-    assert((_value.size() == _chunk_size));
+    auto _size = impl::size(_comm);
+    //check the chunk_size against the root before the data is gathered
+    auto _chunk_size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, _dest, _chunk_size);
     //resize bucket to take all elements
     if (_rank == _dest)
     {
@@ -140,33 +544,85 @@ auto gather_impl(int _dest, MPI_Comm _comm, const std::vector<T> &_value, std::v
             _bucket.resize(_size * _chunk_size);
     }
     //gather the data
-    MPI_Gather(_value.data(), _chunk_size, type_wrapper<T>{}, _bucket.data(), _chunk_size, type_wrapper<T>{}, _dest, _comm);
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Gather)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _dest, _comm);
+}
+template <class T>
+auto gather_impl(int _dest, MPI_Comm _comm, const view<T> &_value, std::vector<T> &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //get current rank
+    auto _rank = impl::rank(_comm);
+    //get world size
+    auto _size = static_cast<size_t>(impl::size(_comm));
+    //every view has to cover the same number of elements
+    auto _chunk_size = static_cast<size_t>(_value.size());
+    if (impl::negotiate_size())
+        impl::check_size(_comm, _dest, _chunk_size);
+    //resize bucket to take all elements
+    if (_rank == _dest)
+    {
+        if (_size * _chunk_size != _bucket.size())
+            _bucket.resize(_size * _chunk_size);
+    }
+    //the view is sent as one element of its type and received as plain elements
+    MPI_Gather(_value.data(), 1, _value.type(), _bucket.data(), _value.size(), type_wrapper<T>{}, _dest, _comm);
 }
 #pragma endregion
 #pragma region receive
 //declarations
 auto recv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, std::string &_value) -> void;
 //templates
+//maps, sets and vectors of non-trivial elements arrive packed
 template <class T>
-auto recv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, T &_value) -> void
+auto recv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, T &_value, std::true_type) -> void
+{
+    impl::recv_packed(_source, _tag, _comm, _status).unpack(_value);
+}
+template <class T>
+auto recv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, T &_value, std::false_type) -> void
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
     MPI_Recv(&_value, 1, type_wrapper<T>{}, _source, _tag, _comm, _status);
 }
 template <class T>
-auto recv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, std::vector<T> &_value) -> void
+auto recv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, std::vector<T> &_value, std::false_type) -> void
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
     //we need to find the proper size of the incoming data
     MPI_Probe(_source, _tag, _comm, _status);
-    auto _size = int{};
-    MPI_Get_count(_status, type_wrapper<T>{}, &_size);
+    auto _size = impl::get_count(_status, type_wrapper<T>{});
     //we need to allocate some memory for it
     _value.resize(_size);
     //we need to receive it
-    MPI_Recv(_value.data(), _size, type_wrapper<T>{}, _source, _tag, _comm, _status);
+    auto _count = impl::large_count{_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Recv)(_value.data(), _count.count(), _count.type(), _source, _tag, _comm, _status);
+}
+template <class T>
+auto recv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _tag, true);
+    recv_impl(_source, _tag, _comm, _status, _value, impl::is_serialized<T>{});
+}
+template <class T>
+auto recv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _tag, true);
+    recv_impl(_source, _tag, _comm, _status, _value, impl::is_serialized<std::vector<T>>{});
+}
+template <class T>
+auto recv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, view<T> _value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _tag, true);
+    MPI_Recv(_value.data(), 1, _value.type(), _source, _tag, _comm, _status);
 }
 #pragma endregion
 #pragma region reduce
@@ -179,7 +635,7 @@ auto reduce_impl(int _dest, MPI_Comm _comm, const T &_value, T &_bucket, op *_op
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     //reduce the data
-    MPI_Reduce(&_value, &_bucket, 1, type_wrapper<T>{}, _operation->get(), _dest, _comm);
+    MPI_Reduce(&_value, &_bucket, 1, _operation->type(type_wrapper<T>{}), _operation->get(), _dest, _comm);
 }
 template <class T>
 auto reduce_impl(int _dest, MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
@@ -187,20 +643,23 @@ auto reduce_impl(int _dest, MPI_Comm _comm, const std::vector<T> &_value, std::v
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the chunk_size before the data is reduced
-    auto _size = (_rank == _dest) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(_dest)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
+    auto _rank = impl::rank(_comm);
+    //check the chunk_size against the root before the data is reduced
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, _dest, _size);
     //resize bucket to take all elements
     if (_rank == _dest)
     {
         if (_size != _bucket.size())
             _bucket.resize(_size);
     }
-    //reduce the data
-    MPI_Reduce(_value.data(), _bucket.data(), _size, type_wrapper<T>{}, _operation->get(), _dest, _comm);
+    //reduce the data in chunks, like allreduce
+    for (auto _offset = size_t{}; _offset < _size; _offset += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_size - _offset, impl::max_count));
+        MPIWRAP_LARGE(MPI_Reduce)(_value.data() + _offset, (_rank == _dest) ? _bucket.data() + _offset : nullptr, _count, _operation->type(type_wrapper<T>{}), _operation->get(), _dest, _comm);
+    }
 }
 #pragma endregion
 #pragma region local reduce
@@ -217,7 +676,7 @@ auto reduce(const T &_value, T &_bucket, op *_operation) -> void
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     //reduce the data
-    MPI_Reduce_local(&_value, &_bucket, 1, type_wrapper<T>{}, _operation->get());
+    MPI_Reduce_local(&_value, &_bucket, 1, _operation->type(type_wrapper<T>{}), _operation->get());
 }
 template <class T>
 auto reduce(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
@@ -227,8 +686,12 @@ auto reduce(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operatio
     //resize bucket to take all elements
     if (_value.size() != _bucket.size())
         _bucket.resize(_value.size());
-    //reduce the data
-    MPI_Reduce_local(_value.data(), _bucket.data(), _value.size(), type_wrapper<T>{}, _operation->get());
+    //reduce the data in chunks, like allreduce
+    for (auto _offset = size_t{}; _offset < _value.size(); _offset += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_value.size() - _offset, impl::max_count));
+        MPIWRAP_LARGE(MPI_Reduce_local)(_value.data() + _offset, _bucket.data() + _offset, _count, _operation->type(type_wrapper<T>{}), _operation->get());
+    }
 }
 template <class T>
 auto reduce(const std::vector<T> &_value, op *_operation) -> std::vector<T>
@@ -299,93 +762,376 @@ auto scatter_impl(int _source, MPI_Comm _comm, const std::vector<T> &_value, std
     if (_chunk_size != _bucket.size())
         _bucket.resize(_chunk_size);
     //scatter the data
-    MPI_Scatter(_value.data(), _chunk_size, type_wrapper<T>{}, _bucket.data(), _chunk_size, type_wrapper<T>{}, _source, _comm);
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Scatter)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _source, _comm);
 }
 #pragma endregion
-#pragma region send
-//declarations
-auto send_impl(int _dest, int _tag, MPI_Comm _comm, const std::string &_value) -> void;
+#pragma region variable counts
 //templates
 template <class T>
-auto send_impl(int _dest, int _tag, MPI_Comm _comm, const T &_value) -> void
+auto allgatherv_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, const impl::v_counts &_counts) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Send(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm);
+    //every process needs the counts of all processes
+    assert((_counts._counts.size() == static_cast<size_t>(impl::size(_comm))));
+    //resize bucket to take all elements
+    if (_counts._total != _bucket.size())
+        _bucket.resize(_counts._total);
+    //gather the data
+    MPIWRAP_LARGE(MPI_Allgatherv)(_value.data(), static_cast<impl::count_type>(_value.size()), type_wrapper<T>{}, _bucket.data(), _counts._counts.data(), _counts._displacements.data(), type_wrapper<T>{}, _comm);
 }
 template <class T>
-auto send_impl(int _dest, int _tag, MPI_Comm _comm, const std::vector<T> &_value) -> void
+auto alltoallv_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, const impl::v_counts &_send_counts, const impl::v_counts &_recv_counts) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Send(_value.data(), _value.size(), type_wrapper<T>{}, _dest, _tag, _comm);
+    //one count for every process in both directions
+    assert((_send_counts._counts.size() == static_cast<size_t>(impl::size(_comm))));
+    assert((_recv_counts._counts.size() == _send_counts._counts.size()));
+    assert((_value.size() >= _send_counts._total));
+    //resize bucket to take all elements
+    if (_recv_counts._total != _bucket.size())
+        _bucket.resize(_recv_counts._total);
+    //exchange the data
+    MPIWRAP_LARGE(MPI_Alltoallv)(_value.data(), _send_counts._counts.data(), _send_counts._displacements.data(), type_wrapper<T>{}, _bucket.data(), _recv_counts._counts.data(), _recv_counts._displacements.data(), type_wrapper<T>{}, _comm);
 }
-#pragma endregion
-#pragma region synchronized send
-//declarations
-auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const std::string &_value) -> void;
-//templates
 template <class T>
-auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const T &_value) -> void
+auto gatherv_impl(int _dest, MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, const impl::v_counts &_counts) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Ssend(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm);
+    //the counts are only significant at the root
+    if (impl::rank(_comm) == _dest)
+    {
+        assert((_counts._counts.size() == static_cast<size_t>(impl::size(_comm))));
+        //resize bucket to take all elements
+        if (_counts._total != _bucket.size())
+            _bucket.resize(_counts._total);
+    }
+    //gather the data
+    MPIWRAP_LARGE(MPI_Gatherv)(_value.data(), static_cast<impl::count_type>(_value.size()), type_wrapper<T>{}, _bucket.data(), _counts._counts.data(), _counts._displacements.data(), type_wrapper<T>{}, _dest, _comm);
 }
 template <class T>
-auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const std::vector<T> &_value) -> void
+auto scatterv_impl(int _source, MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, const impl::v_counts &_counts, const size_t _chunk_size) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Ssend(_value.data(), _value.size(), type_wrapper<T>{}, _dest, _tag, _comm);
+    //the counts are only significant at the root
+    if (impl::rank(_comm) == _source)
+    {
+        assert((_counts._counts.size() == static_cast<size_t>(impl::size(_comm))));
+        assert((_value.size() >= _counts._total));
+    }
+    //resize bucket to take all elements
+    if (_chunk_size != _bucket.size())
+        _bucket.resize(_chunk_size);
+    //scatter the data
+    MPIWRAP_LARGE(MPI_Scatterv)(_value.data(), _counts._counts.data(), _counts._displacements.data(), type_wrapper<T>{}, _bucket.data(), static_cast<impl::count_type>(_chunk_size), type_wrapper<T>{}, _source, _comm);
 }
 #pragma endregion
-#pragma region ready mode send
-//declarations
-auto rsend_impl(int _dest, int _tag, MPI_Comm _comm, const std::string &_value) -> void;
+#pragma region neighbor collectives
 //templates
 template <class T>
-auto rsend_impl(int _dest, int _tag, MPI_Comm _comm, const T &_value) -> void
+auto neighbor_allgather_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Rsend(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm);
+    //check the chunk_size against the root before the data is gathered
+    auto _chunk_size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _chunk_size);
+    //resize bucket to take one chunk per source
+    auto _sources = static_cast<size_t>(impl::neighbor_count(_comm).first);
+    if (_sources * _chunk_size != _bucket.size())
+        _bucket.resize(_sources * _chunk_size);
+    //gather the data
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Neighbor_allgather)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm);
 }
 template <class T>
-auto rsend_impl(int _dest, int _tag, MPI_Comm _comm, const std::vector<T> &_value) -> void
+auto neighbor_alltoall_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Rsend(_value.data(), _value.size(), type_wrapper<T>{}, _dest, _tag, _comm);
+    //one chunk per destination goes out, one chunk per source comes in
+    auto _neighbors = impl::neighbor_count(_comm);
+    assert((_value.size() >= _chunk_size * _neighbors.second));
+    auto _size = _chunk_size * _neighbors.first;
+    //resize bucket to take all elements
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
+    //exchange the data
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Neighbor_alltoall)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm);
 }
 #pragma endregion
-#pragma region send and receive
-//declarations
-auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm _comm, MPI_Status *_status, const std::string &_value, std::string &_bucket) -> void;
-//templates
-template <class T, class U>
-auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm _comm, MPI_Status *_status, const U &_value, T &_bucket) -> void
+#pragma region scan
+namespace impl
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-    //we need to find the proper size of the incoming data
-    auto _sendsize = 1;
-    auto _recvsize = int{};
-    MPI_Sendrecv(&_sendsize, 1, type_wrapper<int>{}, _dest, _sendtag, &_recvsize, 1, type_wrapper<int>{}, _source, _recvtag, _comm, _status);
-    //check size
-    assert((1 == _recvsize));
+//the first process has no predecessors in an exclusive scan, MPI leaves its bucket undefined
+template <class T>
+auto clear_values(T &_value) -> void
+{
+    _value = T{};
+}
+template <class T>
+auto clear_values(std::vector<T> &_value) -> void
+{
+    _value.assign(_value.size(), T{});
+}
+} // namespace impl
+//templates
+template <class T>
+auto scan_impl(MPI_Comm _comm, const T &_value, T &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //scan the data
+    MPI_Scan(&_value, &_bucket, 1, _operation->type(type_wrapper<T>{}), _operation->get(), _comm);
+}
+template <class T>
+auto scan_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //check the size against the root before the data is scanned
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
+    //resize bucket to take all elements
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
+    //scan the data, the scan works elementwise, so large buffers are scanned in chunks
+    for (auto _offset = size_t{}; _offset < _size; _offset += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_size - _offset, impl::max_count));
+        MPIWRAP_LARGE(MPI_Scan)(_value.data() + _offset, _bucket.data() + _offset, _count, _operation->type(type_wrapper<T>{}), _operation->get(), _comm);
+    }
+}
+template <class T>
+auto exscan_impl(MPI_Comm _comm, const T &_value, T &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //scan the data
+    MPI_Exscan(&_value, &_bucket, 1, _operation->type(type_wrapper<T>{}), _operation->get(), _comm);
+    if (impl::rank(_comm) == 0)
+        impl::clear_values(_bucket);
+}
+template <class T>
+auto exscan_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //check the size against the root before the data is scanned
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
+    //resize bucket to take all elements
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
+    //scan the data, the scan works elementwise, so large buffers are scanned in chunks
+    for (auto _offset = size_t{}; _offset < _size; _offset += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_size - _offset, impl::max_count));
+        MPIWRAP_LARGE(MPI_Exscan)(_value.data() + _offset, _bucket.data() + _offset, _count, _operation->type(type_wrapper<T>{}), _operation->get(), _comm);
+    }
+    if (impl::rank(_comm) == 0)
+        impl::clear_values(_bucket);
+}
+#pragma endregion
+#pragma region reduce scatter
+//templates
+template <class T>
+auto reduce_scatter_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, const impl::v_counts &_counts, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //every process contributes all elements and keeps its own share of the result
+    assert((_counts._counts.size() == static_cast<size_t>(impl::size(_comm))));
+    assert((_value.size() == _counts._total));
+    //resize bucket to take all elements
+    auto _chunk_size = static_cast<size_t>(_counts._counts[impl::rank(_comm)]);
+    if (_chunk_size != _bucket.size())
+        _bucket.resize(_chunk_size);
+    //reduce and scatter the data
+    MPIWRAP_LARGE(MPI_Reduce_scatter)(_value.data(), _bucket.data(), _counts._counts.data(), _operation->type(type_wrapper<T>{}), _operation->get(), _comm);
+}
+template <class T>
+auto reduce_scatter_block_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //every process keeps an equally sized block of the result
+    auto _size = static_cast<size_t>(impl::size(_comm));
+    assert((_value.size() % _size == 0));
+    auto _chunk_size = _value.size() / _size;
+    //resize bucket to take all elements
+    if (_chunk_size != _bucket.size())
+        _bucket.resize(_chunk_size);
+    //reduce and scatter the data
+    if (_chunk_size <= impl::max_count)
+    {
+        MPIWRAP_LARGE(MPI_Reduce_scatter_block)(_value.data(), _bucket.data(), static_cast<impl::count_type>(_chunk_size), _operation->type(type_wrapper<T>{}), _operation->get(), _comm);
+        return;
+    }
+    //larger blocks are reduced in chunks, the same part of every block is copied together first
+    auto _staging = std::vector<T>{};
+    for (auto _offset = size_t{}; _offset < _chunk_size; _offset += impl::max_count)
+    {
+        auto _count = std::min(_chunk_size - _offset, impl::max_count);
+        _staging.resize(_size * _count);
+        for (auto i = size_t{}; i < _size; ++i)
+            std::copy_n(_value.data() + i * _chunk_size + _offset, _count, _staging.data() + i * _count);
+        MPIWRAP_LARGE(MPI_Reduce_scatter_block)(_staging.data(), _bucket.data() + _offset, static_cast<impl::count_type>(_count), _operation->type(type_wrapper<T>{}), _operation->get(), _comm);
+    }
+}
+#pragma endregion
+#pragma region send
+//declarations
+auto send_impl(int _dest, int _tag, MPI_Comm _comm, const std::string &_value) -> void;
+//templates
+//maps, sets and vectors of non-trivial elements are sent packed
+template <class T>
+auto send_impl(int _dest, int _tag, MPI_Comm _comm, const T &_value, std::true_type) -> void
+{
+    impl::send_packed(_dest, _tag, _comm, impl::packed{_value});
+}
+template <class T>
+auto send_impl(int _dest, int _tag, MPI_Comm _comm, const T &_value, std::false_type) -> void
+{
+    MPI_Send(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm);
+}
+template <class T>
+auto send_impl(int _dest, int _tag, MPI_Comm _comm, const std::vector<T> &_value, std::false_type) -> void
+{
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Send)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm);
+}
+template <class T>
+auto send_impl(int _dest, int _tag, MPI_Comm _comm, const T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    send_impl(_dest, _tag, _comm, _value, impl::is_serialized<T>{});
+}
+template <class T>
+auto send_impl(int _dest, int _tag, MPI_Comm _comm, const std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    send_impl(_dest, _tag, _comm, _value, impl::is_serialized<std::vector<T>>{});
+}
+template <class T>
+auto send_impl(int _dest, int _tag, MPI_Comm _comm, const view<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Send(_value.data(), 1, _value.type(), _dest, _tag, _comm);
+}
+#pragma endregion
+#pragma region synchronized send
+//declarations
+auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const std::string &_value) -> void;
+auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const impl::packed &_value) -> void;
+//templates
+//maps, sets and vectors of non-trivial elements are sent packed
+template <class T>
+auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const T &_value, std::true_type) -> void
+{
+    ssend_impl(_dest, _tag, _comm, impl::packed{_value});
+}
+template <class T>
+auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const T &_value, std::false_type) -> void
+{
+    MPI_Ssend(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm);
+}
+template <class T>
+auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const std::vector<T> &_value, std::false_type) -> void
+{
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Ssend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm);
+}
+template <class T>
+auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    ssend_impl(_dest, _tag, _comm, _value, impl::is_serialized<T>{});
+}
+template <class T>
+auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    ssend_impl(_dest, _tag, _comm, _value, impl::is_serialized<std::vector<T>>{});
+}
+#pragma endregion
+#pragma region ready mode send
+//declarations
+auto rsend_impl(int _dest, int _tag, MPI_Comm _comm, const std::string &_value) -> void;
+//templates
+//packed values are only received after a probe, so a ready mode send never finds its receive posted
+template <class T>
+auto rsend_impl(int _dest, int _tag, MPI_Comm _comm, const T &_value) -> void
+{
+    static_assert(!impl::is_serialized<T>::value, "serialized types cannot be sent in ready mode");
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Rsend(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm);
+}
+template <class T>
+auto rsend_impl(int _dest, int _tag, MPI_Comm _comm, const std::vector<T> &_value) -> void
+{
+    static_assert(!impl::is_serialized<std::vector<T>>::value, "serialized types cannot be sent in ready mode");
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Rsend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm);
+}
+#pragma endregion
+#pragma region send and receive
+//declarations
+auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm _comm, MPI_Status *_status, const std::string &_value, std::string &_bucket) -> void;
+//templates
+template <class T, class U>
+auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm _comm, MPI_Status *_status, const U &_value, T &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _recvtag, true);
+    //we need to find the proper size of the incoming data
+    auto _sendsize = std::uint64_t{1};
+    auto _recvsize = std::uint64_t{};
+    MPI_Sendrecv(&_sendsize, 1, MPI_UINT64_T, _dest, _sendtag, &_recvsize, 1, MPI_UINT64_T, _source, _recvtag, _comm, _status);
+    //check size
+    assert((1 == _recvsize));
     //send and receive
     MPI_Sendrecv(&_value, _sendsize, type_wrapper<U>{}, _dest, _sendtag, &_bucket, _recvsize, type_wrapper<T>{}, _source, _recvtag, _comm, _status);
 }
 template <class T, class U>
+auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm _comm, MPI_Status *_status, const view<U> &_value, view<T> _bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _recvtag, true);
+    //views have a fixed size, so no size has to be exchanged
+    MPI_Sendrecv(_value.data(), 1, _value.type(), _dest, _sendtag, _bucket.data(), 1, _bucket.type(), _source, _recvtag, _comm, _status);
+}
+template <class T, class U>
 auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm _comm, MPI_Status *_status, const U &_value, std::vector<T> &_bucket) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _recvtag, true);
     //we need to find the proper size of the incoming data
-    auto _sendsize = 1;
-    auto _recvsize = int{};
-    MPI_Sendrecv(&_sendsize, 1, type_wrapper<int>{}, _dest, _sendtag, &_recvsize, 1, type_wrapper<int>{}, _source, _recvtag, _comm, _status);
+    auto _sendsize = std::uint64_t{1};
+    auto _recvsize = std::uint64_t{};
+    MPI_Sendrecv(&_sendsize, 1, MPI_UINT64_T, _dest, _sendtag, &_recvsize, 1, MPI_UINT64_T, _source, _recvtag, _comm, _status);
     //we need to allocate some memory for it
     _bucket.resize(_recvsize);
     //send and receive
@@ -396,26 +1142,29 @@ auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _recvtag, true);
     //we need to find the proper size of the incoming data
-    auto _sendsize = 1;
-    auto _recvsize = int{};
-    MPI_Sendrecv(&_sendsize, 1, type_wrapper<int>{}, _dest, _sendtag, &_recvsize, 1, type_wrapper<int>{}, _source, _recvtag, _comm, _status);
-    //we need to allocate some memory for it
-    auto _c_str = std::make_unique<char[]>(_recvsize + 1);
+    auto _sendsize = std::uint64_t{1};
+    auto _recvsize = std::uint64_t{};
+    MPI_Sendrecv(&_sendsize, 1, MPI_UINT64_T, _dest, _sendtag, &_recvsize, 1, MPI_UINT64_T, _source, _recvtag, _comm, _status);
+    //resize bucket to take all characters
+    _bucket.resize(_recvsize);
     //send and receive
-    MPI_Sendrecv(&_value, _sendsize, type_wrapper<U>{}, _dest, _sendtag, _c_str.get(), _recvsize + 1, MPI_CHAR, _source, _recvtag, _comm, _status);
-    //we need to write the value back
-    _bucket = std::string{_c_str.get()};
+    auto _recvcount = impl::large_count{_recvsize, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Sendrecv)(&_value, _sendsize, type_wrapper<U>{}, _dest, _sendtag, &_bucket[0], _recvcount.count(), _recvcount.type(), _source, _recvtag, _comm, _status);
 }
 template <class T, class U>
 auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm _comm, MPI_Status *_status, const std::vector<U> &_value, T &_bucket) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _recvtag, true);
     //we need to find the proper size of the incoming data
-    auto _sendsize = static_cast<int>(_value.size());
-    auto _recvsize = int{};
-    MPI_Sendrecv(&_sendsize, 1, type_wrapper<int>{}, _dest, _sendtag, &_recvsize, 1, type_wrapper<int>{}, _source, _recvtag, _comm, _status);
+    auto _sendsize = static_cast<std::uint64_t>(_value.size());
+    auto _recvsize = std::uint64_t{};
+    MPI_Sendrecv(&_sendsize, 1, MPI_UINT64_T, _dest, _sendtag, &_recvsize, 1, MPI_UINT64_T, _source, _recvtag, _comm, _status);
     //check size
     assert((1 == _recvsize));
     //send and receive
@@ -426,627 +1175,2638 @@ auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _recvtag, true);
     //we need to find the proper size of the incoming data
-    auto _sendsize = static_cast<int>(_value.size());
-    auto _recvsize = int{};
-    MPI_Sendrecv(&_sendsize, 1, type_wrapper<int>{}, _dest, _sendtag, &_recvsize, 1, type_wrapper<int>{}, _source, _recvtag, _comm, _status);
+    auto _sendsize = static_cast<std::uint64_t>(_value.size());
+    auto _recvsize = std::uint64_t{};
+    MPI_Sendrecv(&_sendsize, 1, MPI_UINT64_T, _dest, _sendtag, &_recvsize, 1, MPI_UINT64_T, _source, _recvtag, _comm, _status);
     //we need to allocate some memory for it
     _bucket.resize(_recvsize);
     //we need to receive it
-    MPI_Sendrecv(_value.data(), _sendsize, type_wrapper<U>{}, _dest, _sendtag, _bucket.data(), _recvsize, type_wrapper<T>{}, _source, _recvtag, _comm, _status);
+    auto _sendcount = impl::large_count{_sendsize, type_wrapper<U>{}};
+    auto _recvcount = impl::large_count{_recvsize, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Sendrecv)(_value.data(), _sendcount.count(), _sendcount.type(), _dest, _sendtag, _bucket.data(), _recvcount.count(), _recvcount.type(), _source, _recvtag, _comm, _status);
 }
 template <class U>
 auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm _comm, MPI_Status *_status, const std::vector<U> &_value, std::string &_bucket) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _recvtag, true);
     //we need to find the proper size of the incoming data
-    auto _sendsize = static_cast<int>(_value.size());
-    auto _recvsize = int{};
-    MPI_Sendrecv(&_sendsize, 1, type_wrapper<int>{}, _dest, _sendtag, &_recvsize, 1, type_wrapper<int>{}, _source, _recvtag, _comm, _status);
-    //we need to allocate some memory for it
-    auto _c_str = std::make_unique<char[]>(_recvsize + 1);
+    auto _sendsize = static_cast<std::uint64_t>(_value.size());
+    auto _recvsize = std::uint64_t{};
+    MPI_Sendrecv(&_sendsize, 1, MPI_UINT64_T, _dest, _sendtag, &_recvsize, 1, MPI_UINT64_T, _source, _recvtag, _comm, _status);
+    //resize bucket to take all characters
+    _bucket.resize(_recvsize);
     //send and receive
-    MPI_Sendrecv(_value.data(), _sendsize, type_wrapper<U>{}, _dest, _sendtag, _c_str.get(), _recvsize + 1, MPI_CHAR, _source, _recvtag, _comm, _status);
-    //we need to write the value back
-    _bucket = std::string{_c_str.get()};
+    auto _sendcount = impl::large_count{_sendsize, type_wrapper<U>{}};
+    auto _recvcount = impl::large_count{_recvsize, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Sendrecv)(_value.data(), _sendcount.count(), _sendcount.type(), _dest, _sendtag, &_bucket[0], _recvcount.count(), _recvcount.type(), _source, _recvtag, _comm, _status);
 }
 template <class T>
 auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm _comm, MPI_Status *_status, const std::string &_value, T &_bucket) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _recvtag, true);
     //we need to find the proper size of the incoming data
-    auto _sendsize = static_cast<int>(_value.size());
-    auto _recvsize = int{};
-    MPI_Sendrecv(&_sendsize, 1, type_wrapper<int>{}, _dest, _sendtag, &_recvsize, 1, type_wrapper<int>{}, _source, _recvtag, _comm, _status);
+    auto _sendsize = static_cast<std::uint64_t>(_value.size());
+    auto _recvsize = std::uint64_t{};
+    MPI_Sendrecv(&_sendsize, 1, MPI_UINT64_T, _dest, _sendtag, &_recvsize, 1, MPI_UINT64_T, _source, _recvtag, _comm, _status);
     //check size
     assert((1 == _recvsize));
     //send and receive
-    MPI_Sendrecv(_value.c_str(), _sendsize + 1, MPI_CHAR, _dest, _sendtag, &_bucket, _recvsize, type_wrapper<T>{}, _source, _recvtag, _comm, _status);
+    auto _sendcount = impl::large_count{_sendsize, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Sendrecv)(_value.data(), _sendcount.count(), _sendcount.type(), _dest, _sendtag, &_bucket, _recvsize, type_wrapper<T>{}, _source, _recvtag, _comm, _status);
 }
 template <class T>
 auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm _comm, MPI_Status *_status, const std::string &_value, std::vector<T> &_bucket) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _recvtag, true);
     //we need to find the proper size of the incoming data
-    auto _sendsize = static_cast<int>(_value.size());
-    auto _recvsize = int{};
-    MPI_Sendrecv(&_sendsize, 1, type_wrapper<int>{}, _dest, _sendtag, &_recvsize, 1, type_wrapper<int>{}, _source, _recvtag, _comm, _status);
+    auto _sendsize = static_cast<std::uint64_t>(_value.size());
+    auto _recvsize = std::uint64_t{};
+    MPI_Sendrecv(&_sendsize, 1, MPI_UINT64_T, _dest, _sendtag, &_recvsize, 1, MPI_UINT64_T, _source, _recvtag, _comm, _status);
     //we need to allocate some memory for it
     _bucket.resize(_recvsize);
     //send and receive
-    MPI_Sendrecv(_value.c_str(), _sendsize + 1, MPI_CHAR, _dest, _sendtag, &_bucket, _recvsize, type_wrapper<T>{}, _source, _recvtag, _comm, _status);
+    auto _sendcount = impl::large_count{_sendsize, MPI_CHAR};
+    auto _recvcount = impl::large_count{_recvsize, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Sendrecv)(_value.data(), _sendcount.count(), _sendcount.type(), _dest, _sendtag, _bucket.data(), _recvcount.count(), _recvcount.type(), _source, _recvtag, _comm, _status);
 }
 #pragma endregion
 
-#pragma region nonblocking allgather
-//declarations
-auto iallgather_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket) -> void;
-//templates
+#pragma region hierarchical collectives
+namespace impl
+{
 template <class T>
-auto iallgather_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket) -> void
+auto node_allgather(const hierarchy_info &_layout, int _rank, const T *_value, int _chunk_size, std::vector<T> &_bucket) -> void
+{
+    auto _size = static_cast<int>(_layout._leader_of.size());
+    auto _nodes = _layout._node_sizes.size();
+    //every node fills one block, the blocks are ordered by leader
+    auto _counts = std::vector<int>(_nodes);
+    auto _displs = std::vector<int>(_nodes);
+    for (auto i = size_t{}; i < _nodes; ++i)
+    {
+        _counts[i] = _layout._node_sizes[i] * _chunk_size;
+        _displs[i] = (i == 0) ? 0 : _displs[i - 1] + _counts[i - 1];
+    }
+    //without contiguous nodes the data has to be reordered afterwards
+    auto _gathered = std::vector<T>{};
+    auto &_target = _layout.is_ordered ? _bucket : _gathered;
+    _target.resize(_size * _chunk_size);
+    //gather inside the node, exchange the node blocks among the leaders and hand everything back to the node
+    auto _block = _target.data() + _displs[_layout._leader_of[_rank]];
+    MPI_Gather(_value, _chunk_size, type_wrapper<T>{}, _block, _chunk_size, type_wrapper<T>{}, 0, _layout._node);
+    if (_layout._leaders != MPI_COMM_NULL)
+        MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, _target.data(), _counts.data(), _displs.data(), type_wrapper<T>{}, _layout._leaders);
+    MPI_Bcast(_target.data(), _size * _chunk_size, type_wrapper<T>{}, 0, _layout._node);
+    if (_layout.is_ordered)
+        return;
+    _bucket.resize(_size * _chunk_size);
+    for (auto i = 0; i < _size; ++i)
+        std::copy_n(_gathered.data() + i * _chunk_size, _chunk_size, _bucket.data() + _layout._order[i] * _chunk_size);
+}
+template <class T>
+auto node_allreduce(const hierarchy_info &_layout, const T *_value, T *_bucket, count_type _size, op *_operation) -> void
+{
+    //reduce onto the node leader, combine among the leaders and hand the result back to the node
+    MPIWRAP_LARGE(MPI_Reduce)(_value, _bucket, _size, _operation->type(type_wrapper<T>{}), _operation->get(), 0, _layout._node);
+    if (_layout._leaders != MPI_COMM_NULL)
+        MPIWRAP_LARGE(MPI_Allreduce)(MPI_IN_PLACE, _bucket, _size, _operation->type(type_wrapper<T>{}), _operation->get(), _layout._leaders);
+    MPIWRAP_LARGE(MPI_Bcast)(_bucket, _size, type_wrapper<T>{}, 0, _layout._node);
+}
+template <class T>
+auto node_reduce(const hierarchy_info &_layout, int _dest, int _rank, const T *_value, T *_bucket, count_type _size, op *_operation) -> void
+{
+    auto _leader = _layout._leader_of[_dest];
+    auto _node_rank = _layout._node_rank[_rank];
+    //node leaders need room for the partial result, the root can use its bucket
+    auto _partial = std::vector<T>{};
+    if (_node_rank == 0 && _rank != _dest)
+        _partial.resize(_size);
+    auto _data = (_rank == _dest) ? _bucket : _partial.data();
+    MPIWRAP_LARGE(MPI_Reduce)(_value, _data, _size, _operation->type(type_wrapper<T>{}), _operation->get(), 0, _layout._node);
+    if (_layout._leaders != MPI_COMM_NULL)
+    {
+        if (impl::rank(_layout._leaders) == _leader)
+            MPIWRAP_LARGE(MPI_Reduce)(MPI_IN_PLACE, _data, _size, _operation->type(type_wrapper<T>{}), _operation->get(), _leader, _layout._leaders);
+        else
+            MPIWRAP_LARGE(MPI_Reduce)(_data, nullptr, _size, _operation->type(type_wrapper<T>{}), _operation->get(), _leader, _layout._leaders);
+    }
+    //the leader passes the result on if the root is not the leader itself
+    auto _dest_node_rank = _layout._node_rank[_dest];
+    if (_dest_node_rank == 0 || _layout._leader_of[_rank] != _leader)
+        return;
+    if (_node_rank == 0)
+        MPIWRAP_LARGE(MPI_Send)(_data, _size, type_wrapper<T>{}, _dest_node_rank, 0, _layout._node);
+    else if (_rank == _dest)
+        MPIWRAP_LARGE(MPI_Recv)(_data, _size, type_wrapper<T>{}, 0, 0, _layout._node, MPI_STATUS_IGNORE);
+}
+template <class T>
+auto node_bcast(const hierarchy_info &_layout, int _source, int _rank, T &_value) -> void
+{
+    auto _leader = _layout._leader_of[_source];
+    auto _source_node_rank = _layout._node_rank[_source];
+    //the leader of the root's node needs the data first
+    if (_source_node_rank != 0 && _layout._leader_of[_rank] == _leader)
+    {
+        if (_rank == _source)
+            send_impl(0, 0, _layout._node, _value);
+        else if (_layout._node_rank[_rank] == 0)
+        {
+            //vectors and strings are probed, so the status cannot be ignored
+            auto _status = MPI_Status{};
+            recv_impl(_source_node_rank, 0, _layout._node, &_status, _value);
+        }
+    }
+    if (_layout._leaders != MPI_COMM_NULL)
+        bcast_impl(_leader, _layout._leaders, _value);
+    bcast_impl(0, _layout._node, _value);
+}
+} // namespace impl
+template <class T>
+auto allgather_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, hierarchy _mode) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //get world size
-    auto _size = comm(_comm)->size();
-    //broadcast the chunk_size before the data is gathered
-    auto _chunk_size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_chunk_size);
-    //check size
-    assert((_value.size() == _chunk_size));
-    //resize bucket to take all elements
-    if (_size * _chunk_size != _bucket.size())
-        _bucket.resize(_size * _chunk_size);
-    //gather the data
-    MPI_Iallgather(_value.data(), _chunk_size, type_wrapper<T>{}, _bucket.data(), _chunk_size, type_wrapper<T>{}, _comm, _request);
+    //the node blocks are exchanged with int displacements, so larger buffers are gathered flat
+    auto _layout = (impl::size(_comm) * _value.size() <= static_cast<size_t>(std::numeric_limits<int>::max())) ? impl::node_layout(_comm, _mode) : nullptr;
+    if (_layout == nullptr)
+        return allgather_impl(_comm, _value, _bucket);
+    //check the chunk_size against the root before the data is gathered
+    auto _chunk_size = static_cast<int>(_value.size());
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _chunk_size);
+    impl::node_allgather(*_layout, impl::rank(_comm), _value.data(), _chunk_size, _bucket);
 }
-#pragma endregion
-#pragma region nonblocking allreduce
-//declarations
-auto iallreduce_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket, op *_operation) -> void;
-//templates
 template <class T>
-auto iallreduce_impl(MPI_Comm _comm, MPI_Request *_request, const T &_value, T &_bucket, op *_operation) -> void
+auto allreduce_impl(MPI_Comm _comm, const T &_value, T &_bucket, op *_operation, hierarchy _mode) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //reduce the data
-    MPI_Reduce(&_value, &_bucket, 1, type_wrapper<T>{}, _operation->get(), _comm, _request);
+    //the order of the operands changes, so only commutative operations can run on two levels
+    auto _layout = _operation->commutes() ? impl::node_layout(_comm, _mode) : nullptr;
+    if (_layout == nullptr)
+        return allreduce_impl(_comm, _value, _bucket, _operation);
+    impl::node_allreduce(*_layout, &_value, &_bucket, 1, _operation);
 }
 template <class T>
-auto iallreduce_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+auto allreduce_impl(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation, hierarchy _mode) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the chunk_size before the data is reduced
-    auto _size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
+    //the order of the operands changes, so only commutative operations can run on two levels
+    auto _layout = _operation->commutes() ? impl::node_layout(_comm, _mode) : nullptr;
+    if (_layout == nullptr)
+        return allreduce_impl(_comm, _value, _bucket, _operation);
+    //check the chunk_size against the root before the data is reduced
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
     //resize bucket to take all elements
     if (_size != _bucket.size())
         _bucket.resize(_size);
-    //reduce the data
-    MPI_Iallreduce(_value.data(), _bucket.data(), _size, type_wrapper<T>{}, _operation->get(), _comm, _request);
+    for (auto _offset = size_t{}; _offset < _size; _offset += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_size - _offset, impl::max_count));
+        impl::node_allreduce(*_layout, _value.data() + _offset, _bucket.data() + _offset, _count, _operation);
+    }
 }
-#pragma endregion
-#pragma region nonblocking alltoall
-//declarations
-auto ialltoall_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket, const size_t _chunk_size) -> void;
-//templates
 template <class T>
-auto ialltoall_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
+auto bcast_impl(int _source, MPI_Comm _comm, T &_value, hierarchy _mode) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _layout = impl::node_layout(_comm, _mode);
+    if (_layout == nullptr)
+        return bcast_impl(_source, _comm, _value);
+    impl::node_bcast(*_layout, _source, impl::rank(_comm), _value);
+}
+template <class T>
+auto reduce_impl(int _dest, MPI_Comm _comm, const T &_value, T &_bucket, op *_operation, hierarchy _mode) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //the order of the operands changes, so only commutative operations can run on two levels
+    auto _layout = _operation->commutes() ? impl::node_layout(_comm, _mode) : nullptr;
+    if (_layout == nullptr)
+        return reduce_impl(_dest, _comm, _value, _bucket, _operation);
+    impl::node_reduce(*_layout, _dest, impl::rank(_comm), &_value, &_bucket, 1, _operation);
+}
+template <class T>
+auto reduce_impl(int _dest, MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation, hierarchy _mode) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
+    //the order of the operands changes, so only commutative operations can run on two levels
+    auto _layout = _operation->commutes() ? impl::node_layout(_comm, _mode) : nullptr;
+    if (_layout == nullptr)
+        return reduce_impl(_dest, _comm, _value, _bucket, _operation);
     //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the size before the data is gathered
-    auto _size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
-    //double check size
-    assert((_size >= _chunk_size * comm(_comm)->size()));
+    auto _rank = impl::rank(_comm);
+    //check the chunk_size against the root before the data is reduced
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, _dest, _size);
     //resize bucket to take all elements
-    if (_size != _bucket.size())
-        _bucket.resize(_size);
-    //gather the data
-    MPI_Ialltoall(_value.data(), _chunk_size, type_wrapper<T>{}, _bucket.data(), _chunk_size, type_wrapper<T>{}, _comm, _request);
+    if (_rank == _dest)
+    {
+        if (_size != _bucket.size())
+            _bucket.resize(_size);
+    }
+    for (auto _offset = size_t{}; _offset < _size; _offset += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_size - _offset, impl::max_count));
+        impl::node_reduce(*_layout, _dest, _rank, _value.data() + _offset, (_rank == _dest) ? _bucket.data() + _offset : nullptr, _count, _operation);
+    }
 }
 #pragma endregion
-#pragma region nonblocking broadcast
-//declarations
-auto ibcast_impl(int _source, MPI_Comm _comm, MPI_Request *_request, std::string &_value) -> void;
-//templates
+
+#pragma region one-sided
 template <class T>
-auto ibcast_impl(int _source, MPI_Comm _comm, MPI_Request *_request, T &_value) -> void
+auto put_impl(int _target, MPI_Aint _offset, MPI_Win _window, const T &_value) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Ibcast(&_value, 1, type_wrapper<T>{}, _source, _comm, _request);
+    MPI_Put(&_value, 1, type_wrapper<T>{}, _target, _offset, 1, type_wrapper<T>{}, _window);
 }
 template <class T>
-auto ibcast_impl(int _source, MPI_Comm _comm, MPI_Request *_request, std::vector<T> &_value) -> void
+auto put_impl(int _target, MPI_Aint _offset, MPI_Win _window, const std::vector<T> &_value) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the size before the data
-    auto _size = (_rank == _source) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(_source)->bcast(_size);
-    //resize the vector if not the sender
-    if (_rank != _source)
-        _value.resize(_size);
-    //broadcast the data
-    MPI_Ibcast(_value.data(), _size, type_wrapper<T>{}, _source, _comm, _request);
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Put)(_value.data(), _count.count(), _count.type(), _target, _offset, _count.count(), _count.type(), _window);
+}
+template <class T>
+auto get_impl(int _target, MPI_Aint _offset, MPI_Win _window, T &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Get(&_bucket, 1, type_wrapper<T>{}, _target, _offset, 1, type_wrapper<T>{}, _window);
+}
+template <class T>
+auto get_impl(int _target, MPI_Aint _offset, MPI_Win _window, std::vector<T> &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_bucket.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Get)(_bucket.data(), _count.count(), _count.type(), _target, _offset, _count.count(), _count.type(), _window);
+}
+template <class T>
+auto accumulate_impl(int _target, MPI_Aint _offset, MPI_Win _window, const T *_value, size_t _size, MPI_Op _operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //accumulations are reductions, so large buffers are split like in allreduce
+    for (auto _chunk = size_t{}; _chunk < _size; _chunk += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_size - _chunk, impl::max_count));
+        MPIWRAP_LARGE(MPI_Accumulate)(_value + _chunk, _count, type_wrapper<T>{}, _target, _offset + _chunk, _count, type_wrapper<T>{}, _operation, _window);
+    }
+}
+template <class T>
+auto get_accumulate_impl(int _target, MPI_Aint _offset, MPI_Win _window, const T *_value, T *_bucket, size_t _size, MPI_Op _operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    for (auto _chunk = size_t{}; _chunk < _size; _chunk += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_size - _chunk, impl::max_count));
+        MPIWRAP_LARGE(MPI_Get_accumulate)(_value + _chunk, _count, type_wrapper<T>{}, _bucket + _chunk, _count, type_wrapper<T>{}, _target, _offset + _chunk, _count, type_wrapper<T>{}, _operation, _window);
+    }
+}
+template <class T>
+auto rput_impl(int _target, MPI_Aint _offset, MPI_Win _window, MPI_Request *_request, const T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Rput(&_value, 1, type_wrapper<T>{}, _target, _offset, 1, type_wrapper<T>{}, _window, _request);
+}
+template <class T>
+auto rput_impl(int _target, MPI_Aint _offset, MPI_Win _window, MPI_Request *_request, const std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Rput)(_value.data(), _count.count(), _count.type(), _target, _offset, _count.count(), _count.type(), _window, _request);
+}
+template <class T>
+auto rget_impl(int _target, MPI_Aint _offset, MPI_Win _window, MPI_Request *_request, T &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Rget(&_bucket, 1, type_wrapper<T>{}, _target, _offset, 1, type_wrapper<T>{}, _window, _request);
+}
+template <class T>
+auto rget_impl(int _target, MPI_Aint _offset, MPI_Win _window, MPI_Request *_request, std::vector<T> &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_bucket.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Rget)(_bucket.data(), _count.count(), _count.type(), _target, _offset, _count.count(), _count.type(), _window, _request);
+}
+#pragma endregion
+
+#pragma region nonblocking allgather
+//declarations
+auto iallgather_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket) -> void;
+//templates
+template <class T>
+auto iallgather_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //get world size
+    auto _size = impl::size(_comm);
+    //check the chunk_size against the root before the data is gathered
+    auto _chunk_size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _chunk_size);
+    //resize bucket to take all elements
+    if (_size * _chunk_size != _bucket.size())
+        _bucket.resize(_size * _chunk_size);
+    //gather the data
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Iallgather)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking allreduce
+//declarations
+auto iallreduce_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket, op *_operation) -> void;
+//templates
+template <class T>
+auto iallreduce_impl(MPI_Comm _comm, MPI_Request *_request, const T &_value, T &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //reduce the data
+    MPI_Iallreduce(&_value, &_bucket, 1, _operation->type(type_wrapper<T>{}), _operation->get(), _comm, _request);
+}
+template <class T>
+auto iallreduce_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //check the chunk_size against the root before the data is reduced
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
+    //one request cannot be split into chunks, so before MPI-4 the size is limited
+    auto _count = impl::checked_count(_size);
+    //resize bucket to take all elements
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
+    //reduce the data
+    MPIWRAP_LARGE(MPI_Iallreduce)(_value.data(), _bucket.data(), _count, _operation->type(type_wrapper<T>{}), _operation->get(), _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking alltoall
+//declarations
+auto ialltoall_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket, const size_t _chunk_size) -> void;
+//templates
+template <class T>
+auto ialltoall_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //check the size against the root before the data is gathered
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
+    //double check size
+    assert((_size >= _chunk_size * impl::size(_comm)));
+    //resize bucket to take all elements
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
+    //gather the data
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Ialltoall)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking broadcast
+//declarations
+auto ibcast_impl(int _source, MPI_Comm _comm, MPI_Request *_request, std::string &_value) -> void;
+//templates
+template <class T>
+auto ibcast_impl(int _source, MPI_Comm _comm, MPI_Request *_request, T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Ibcast(&_value, 1, type_wrapper<T>{}, _source, _comm, _request);
+}
+template <class T>
+auto ibcast_impl(int _source, MPI_Comm _comm, MPI_Request *_request, std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //get current rank
+    auto _rank = impl::rank(_comm);
+    //broadcast the size before the data
+    auto _size = (_rank == _source) ? static_cast<std::uint64_t>(_value.size()) : std::uint64_t{};
+    MPI_Bcast(&_size, 1, MPI_UINT64_T, _source, _comm);
+    //resize the vector if not the sender
+    if (_rank != _source)
+        _value.resize(_size);
+    //broadcast the data
+    auto _count = impl::large_count{_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Ibcast)(_value.data(), _count.count(), _count.type(), _source, _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking gather
+//declarations
+auto igather_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket) -> void;
+//templates
+template <class T>
+auto igather_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //get current rank
+    auto _rank = impl::rank(_comm);
+    //get world size
+    auto _size = impl::size(_comm);
+    //check the chunk_size against the root before the data is gathered
+    auto _chunk_size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, _dest, _chunk_size);
+    //resize bucket to take all elements
+    if (_rank == _dest)
+    {
+        if (_size * _chunk_size != _bucket.size())
+            _bucket.resize(_size * _chunk_size);
+    }
+    //gather the data
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Igather)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _dest, _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking receive
+//declarations
+auto improbe_impl(int _source, int _tag, MPI_Comm _comm, MPI_Message *_message, MPI_Status *_status, const bool _blocking) -> bool;
+auto irecv_impl(MPI_Message *_message, MPI_Status *_status, MPI_Request *_request, std::string &_value) -> void;
+auto irecv_impl(MPI_Message *_message, MPI_Status *_status, MPI_Request *_request, impl::packed &_value) -> void;
+//templates
+template <class T>
+auto irecv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, MPI_Request *_request, T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Irecv(&_value, 1, type_wrapper<T>{}, _source, _tag, _comm, _request);
+}
+template <class T>
+auto irecv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, MPI_Request *_request, view<T> _value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Irecv(_value.data(), 1, _value.type(), _source, _tag, _comm, _request);
+}
+template <class T>
+auto irecv_impl(MPI_Message *_message, MPI_Status *_status, MPI_Request *_request, std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //the matched probe tells us the proper size of the incoming data
+    auto _size = impl::get_count(_status, type_wrapper<T>{});
+    //we need to allocate some memory for it
+    _value.resize(_size);
+    //we need to receive exactly the probed message
+    auto _count = impl::large_count{_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Imrecv)(_value.data(), _count.count(), _count.type(), _message, _request);
+}
+//vectors of non-trivial elements arrive packed and are unpacked once the request completes
+template <class T>
+auto irecv_impl(MPI_Message *_message, MPI_Status *_status, MPI_Request *_request, std::vector<T> &, impl::packed &_packed, std::true_type) -> void
+{
+    irecv_impl(_message, _status, _request, _packed);
+}
+template <class T>
+auto irecv_impl(MPI_Message *_message, MPI_Status *_status, MPI_Request *_request, std::vector<T> &_value, impl::packed &, std::false_type) -> void
+{
+    irecv_impl(_message, _status, _request, _value);
+}
+#pragma endregion
+#pragma region nonblocking reduce
+//declarations
+auto ireduce_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket, op *_operation) -> void;
+//templates
+template <class T>
+auto ireduce_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const T &_value, T &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //reduce the data
+    MPI_Ireduce(&_value, &_bucket, 1, _operation->type(type_wrapper<T>{}), _operation->get(), _dest, _comm, _request);
+}
+template <class T>
+auto ireduce_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //get current rank
+    auto _rank = impl::rank(_comm);
+    //check the chunk_size against the root before the data is reduced
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, _dest, _size);
+    //one request cannot be split into chunks, so before MPI-4 the size is limited
+    auto _count = impl::checked_count(_size);
+    //resize bucket to take all elements
+    if (_rank == _dest)
+    {
+        if (_size != _bucket.size())
+            _bucket.resize(_size);
+    }
+    //reduce the data
+    MPIWRAP_LARGE(MPI_Ireduce)(_value.data(), _bucket.data(), _count, _operation->type(type_wrapper<T>{}), _operation->get(), _dest, _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking scatter
+//declarations
+auto iscatter_impl(int _source, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket, const size_t _chunk_size) -> void;
+//templates
+template <class T>
+auto iscatter_impl(int _source, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //resize bucket to take all elements
+    if (_chunk_size != _bucket.size())
+        _bucket.resize(_chunk_size);
+    //scatter the data
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Iscatter)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _source, _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking variable counts
+//templates
+template <class T>
+auto iallgatherv_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, const impl::v_counts &_counts) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //every process needs the counts of all processes
+    assert((_counts._counts.size() == static_cast<size_t>(impl::size(_comm))));
+    //resize bucket to take all elements
+    if (_counts._total != _bucket.size())
+        _bucket.resize(_counts._total);
+    //gather the data
+    MPIWRAP_LARGE(MPI_Iallgatherv)(_value.data(), static_cast<impl::count_type>(_value.size()), type_wrapper<T>{}, _bucket.data(), _counts._counts.data(), _counts._displacements.data(), type_wrapper<T>{}, _comm, _request);
+}
+template <class T>
+auto ialltoallv_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, const impl::v_counts &_send_counts, const impl::v_counts &_recv_counts) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //one count for every process in both directions
+    assert((_send_counts._counts.size() == static_cast<size_t>(impl::size(_comm))));
+    assert((_recv_counts._counts.size() == _send_counts._counts.size()));
+    assert((_value.size() >= _send_counts._total));
+    //resize bucket to take all elements
+    if (_recv_counts._total != _bucket.size())
+        _bucket.resize(_recv_counts._total);
+    //exchange the data
+    MPIWRAP_LARGE(MPI_Ialltoallv)(_value.data(), _send_counts._counts.data(), _send_counts._displacements.data(), type_wrapper<T>{}, _bucket.data(), _recv_counts._counts.data(), _recv_counts._displacements.data(), type_wrapper<T>{}, _comm, _request);
+}
+template <class T>
+auto igatherv_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, const impl::v_counts &_counts) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //the counts are only significant at the root
+    if (impl::rank(_comm) == _dest)
+    {
+        assert((_counts._counts.size() == static_cast<size_t>(impl::size(_comm))));
+        //resize bucket to take all elements
+        if (_counts._total != _bucket.size())
+            _bucket.resize(_counts._total);
+    }
+    //gather the data
+    MPIWRAP_LARGE(MPI_Igatherv)(_value.data(), static_cast<impl::count_type>(_value.size()), type_wrapper<T>{}, _bucket.data(), _counts._counts.data(), _counts._displacements.data(), type_wrapper<T>{}, _dest, _comm, _request);
+}
+template <class T>
+auto iscatterv_impl(int _source, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, const impl::v_counts &_counts, const size_t _chunk_size) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //the counts are only significant at the root
+    if (impl::rank(_comm) == _source)
+    {
+        assert((_counts._counts.size() == static_cast<size_t>(impl::size(_comm))));
+        assert((_value.size() >= _counts._total));
+    }
+    //resize bucket to take all elements
+    if (_chunk_size != _bucket.size())
+        _bucket.resize(_chunk_size);
+    //scatter the data
+    MPIWRAP_LARGE(MPI_Iscatterv)(_value.data(), _counts._counts.data(), _counts._displacements.data(), type_wrapper<T>{}, _bucket.data(), static_cast<impl::count_type>(_chunk_size), type_wrapper<T>{}, _source, _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking neighbor collectives
+//templates
+template <class T>
+auto ineighbor_allgather_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //check the chunk_size against the root before the data is gathered
+    auto _chunk_size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _chunk_size);
+    //resize bucket to take one chunk per source
+    auto _sources = static_cast<size_t>(impl::neighbor_count(_comm).first);
+    if (_sources * _chunk_size != _bucket.size())
+        _bucket.resize(_sources * _chunk_size);
+    //gather the data
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Ineighbor_allgather)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm, _request);
+}
+template <class T>
+auto ineighbor_alltoall_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //one chunk per destination goes out, one chunk per source comes in
+    auto _neighbors = impl::neighbor_count(_comm);
+    assert((_value.size() >= _chunk_size * _neighbors.second));
+    auto _size = _chunk_size * _neighbors.first;
+    //resize bucket to take all elements
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
+    //exchange the data
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Ineighbor_alltoall)(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking scan
+//templates
+template <class T>
+auto iscan_impl(MPI_Comm _comm, MPI_Request *_request, const T &_value, T &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //scan the data
+    MPI_Iscan(&_value, &_bucket, 1, _operation->type(type_wrapper<T>{}), _operation->get(), _comm, _request);
+}
+template <class T>
+auto iscan_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //check the size against the root before the data is scanned
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
+    //one request cannot be split into chunks, so before MPI-4 the size is limited
+    auto _count = impl::checked_count(_size);
+    //resize bucket to take all elements
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
+    //scan the data
+    MPIWRAP_LARGE(MPI_Iscan)(_value.data(), _bucket.data(), _count, _operation->type(type_wrapper<T>{}), _operation->get(), _comm, _request);
+}
+template <class T>
+auto iexscan_impl(MPI_Comm _comm, MPI_Request *_request, const T &_value, T &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //scan the data
+    MPI_Iexscan(&_value, &_bucket, 1, _operation->type(type_wrapper<T>{}), _operation->get(), _comm, _request);
+}
+template <class T>
+auto iexscan_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //check the size against the root before the data is scanned
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
+    //one request cannot be split into chunks, so before MPI-4 the size is limited
+    auto _count = impl::checked_count(_size);
+    //resize bucket to take all elements
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
+    //scan the data
+    MPIWRAP_LARGE(MPI_Iexscan)(_value.data(), _bucket.data(), _count, _operation->type(type_wrapper<T>{}), _operation->get(), _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking reduce scatter
+//templates
+template <class T>
+auto ireduce_scatter_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, const impl::v_counts &_counts, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //every process contributes all elements and keeps its own share of the result
+    assert((_counts._counts.size() == static_cast<size_t>(impl::size(_comm))));
+    assert((_value.size() == _counts._total));
+    //resize bucket to take all elements
+    auto _chunk_size = static_cast<size_t>(_counts._counts[impl::rank(_comm)]);
+    if (_chunk_size != _bucket.size())
+        _bucket.resize(_chunk_size);
+    //reduce and scatter the data
+    MPIWRAP_LARGE(MPI_Ireduce_scatter)(_value.data(), _bucket.data(), _counts._counts.data(), _operation->type(type_wrapper<T>{}), _operation->get(), _comm, _request);
+}
+template <class T>
+auto ireduce_scatter_block_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //every process keeps an equally sized block of the result
+    auto _size = static_cast<size_t>(impl::size(_comm));
+    assert((_value.size() % _size == 0));
+    auto _chunk_size = _value.size() / _size;
+    //one request cannot be split into chunks, so before MPI-4 the size is limited
+    auto _count = impl::checked_count(_chunk_size);
+    //resize bucket to take all elements
+    if (_chunk_size != _bucket.size())
+        _bucket.resize(_chunk_size);
+    //reduce and scatter the data
+    MPIWRAP_LARGE(MPI_Ireduce_scatter_block)(_value.data(), _bucket.data(), _count, _operation->type(type_wrapper<T>{}), _operation->get(), _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking send
+//declarations
+auto isend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void;
+auto isend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const impl::packed &_value) -> void;
+//templates
+template <class T>
+auto isend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Isend(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm, _request);
+}
+template <class T>
+auto isend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Isend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+template <class T>
+auto isend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const borrowed<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Isend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+template <class T>
+auto isend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const view<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Isend(_value.data(), 1, _value.type(), _dest, _tag, _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking synchronized send
+//declarations
+auto issend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void;
+auto issend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const impl::packed &_value) -> void;
+//templates
+template <class T>
+auto issend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Issend(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm, _request);
+}
+template <class T>
+auto issend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Issend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+template <class T>
+auto issend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const borrowed<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Issend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+#pragma endregion
+#pragma region nonblocking ready mode send
+//declarations
+auto irsend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void;
+//templates
+//packed values are only received after a probe, so a ready mode send never finds its receive posted
+template <class T>
+auto irsend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const T &_value) -> void
+{
+    static_assert(!impl::is_serialized<T>::value, "serialized types cannot be sent in ready mode");
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Irsend(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm, _request);
+}
+template <class T>
+auto irsend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value) -> void
+{
+    static_assert(!impl::is_serialized<std::vector<T>>::value, "serialized types cannot be sent in ready mode");
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Irsend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+template <class T>
+auto irsend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const borrowed<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Irsend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+#pragma endregion
+#pragma region persistent send
+//declarations
+auto send_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void;
+//templates
+template <class T>
+auto send_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Send_init(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm, _request);
+}
+template <class T>
+auto send_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Send_init)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+#pragma endregion
+#pragma region persistent synchronized send
+//declarations
+auto ssend_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void;
+//templates
+template <class T>
+auto ssend_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Ssend_init(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm, _request);
+}
+template <class T>
+auto ssend_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Ssend_init)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+#pragma endregion
+#pragma region persistent ready mode send
+//declarations
+auto rsend_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void;
+//templates
+template <class T>
+auto rsend_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Rsend_init(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm, _request);
+}
+template <class T>
+auto rsend_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Rsend_init)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+#pragma endregion
+#pragma region persistent receive
+//declarations
+auto recv_init_impl(int _source, int _tag, MPI_Comm _comm, MPI_Request *_request, std::string &_value) -> void;
+//templates
+template <class T>
+auto recv_init_impl(int _source, int _tag, MPI_Comm _comm, MPI_Request *_request, T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    MPI_Recv_init(&_value, 1, type_wrapper<T>{}, _source, _tag, _comm, _request);
+}
+template <class T>
+auto recv_init_impl(int _source, int _tag, MPI_Comm _comm, MPI_Request *_request, std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //the message must not be larger than the bucket, it is not resized
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+    MPIWRAP_LARGE(MPI_Recv_init)(_value.data(), _count.count(), _count.type(), _source, _tag, _comm, _request);
+}
+#pragma endregion
+#pragma region persistent broadcast
+template <class T>
+auto bcast_init_impl(int _source, MPI_Comm _comm, MPI_Request *_request, T &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+#if MPI_VERSION >= 4
+    MPI_Bcast_init(&_value, 1, type_wrapper<T>{}, _source, _comm, MPI_INFO_NULL, _request);
+#else
+    MPI_Ibcast(&_value, 1, type_wrapper<T>{}, _source, _comm, _request);
+#endif
+}
+template <class T>
+auto bcast_init_impl(int _source, MPI_Comm _comm, MPI_Request *_request, std::vector<T> &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+#if MPI_VERSION >= 4
+    MPI_Bcast_init_c(_value.data(), _count.count(), _count.type(), _source, _comm, MPI_INFO_NULL, _request);
+#else
+    MPI_Ibcast(_value.data(), _count.count(), _count.type(), _source, _comm, _request);
+#endif
+}
+#pragma endregion
+#pragma region persistent allgather
+template <class T>
+auto allgather_init_impl(MPI_Comm _comm, MPI_Request *_request, const T &_value, std::vector<T> &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+#if MPI_VERSION >= 4
+    MPI_Allgather_init(&_value, 1, type_wrapper<T>{}, _bucket.data(), 1, type_wrapper<T>{}, _comm, MPI_INFO_NULL, _request);
+#else
+    MPI_Iallgather(&_value, 1, type_wrapper<T>{}, _bucket.data(), 1, type_wrapper<T>{}, _comm, _request);
+#endif
+}
+template <class T>
+auto allgather_init_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), type_wrapper<T>{}};
+#if MPI_VERSION >= 4
+    MPI_Allgather_init_c(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm, MPI_INFO_NULL, _request);
+#else
+    MPI_Iallgather(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm, _request);
+#endif
+}
+#pragma endregion
+#pragma region persistent alltoall
+template <class T>
+auto alltoall_init_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_chunk_size, type_wrapper<T>{}};
+#if MPI_VERSION >= 4
+    MPI_Alltoall_init_c(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm, MPI_INFO_NULL, _request);
+#else
+    MPI_Ialltoall(_value.data(), _count.count(), _count.type(), _bucket.data(), _count.count(), _count.type(), _comm, _request);
+#endif
+}
+#pragma endregion
+#pragma region persistent allreduce
+template <class T>
+auto allreduce_init_impl(MPI_Comm _comm, MPI_Request *_request, const T &_value, T &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+#if MPI_VERSION >= 4
+    MPI_Allreduce_init(&_value, &_bucket, 1, _operation->type(type_wrapper<T>{}), _operation->get(), _comm, MPI_INFO_NULL, _request);
+#else
+    MPI_Iallreduce(&_value, &_bucket, 1, _operation->type(type_wrapper<T>{}), _operation->get(), _comm, _request);
+#endif
+}
+template <class T>
+auto allreduce_init_impl(MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //one request cannot be split into chunks, so before MPI-4 the size is limited
+    auto _count = impl::checked_count(_value.size());
+#if MPI_VERSION >= 4
+    MPI_Allreduce_init_c(_value.data(), _bucket.data(), _count, _operation->type(type_wrapper<T>{}), _operation->get(), _comm, MPI_INFO_NULL, _request);
+#else
+    MPI_Iallreduce(_value.data(), _bucket.data(), _count, _operation->type(type_wrapper<T>{}), _operation->get(), _comm, _request);
+#endif
+}
+#pragma endregion
+
+#pragma region communicator
+template <class T>
+auto communicator::allgather(const T &_value, std::vector<T> &_bucket) -> void
+{
+    return allgather(std::vector<T>{_value}, _bucket);
+}
+template <class T>
+auto communicator::allgather(const std::vector<T> &_value, std::vector<T> &_bucket) -> void
+{
+    return allgather_impl(_comm, _value, _bucket, get_hierarchy());
+}
+template <class T>
+auto communicator::allgather(const T &_value, std::vector<T> &_bucket, hierarchy _mode) -> void
+{
+    return allgather(std::vector<T>{_value}, _bucket, _mode);
+}
+template <class T>
+auto communicator::allgather(const std::vector<T> &_value, std::vector<T> &_bucket, hierarchy _mode) -> void
+{
+    return allgather_impl(_comm, _value, _bucket, _mode);
+}
+template <class T>
+auto communicator::allgather(view<T> _value, std::vector<T> &_bucket) -> void
+{
+    return allgather_impl(_comm, _value, _bucket);
+}
+template <class T>
+auto communicator::allgather(const T &_value) -> std::vector<T>
+{
+    return allgather(std::vector<T>{_value});
+}
+template <class T>
+auto communicator::allgather(const std::vector<T> &_value) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    allgather(_value, _bucket);
+    return _bucket;
+}
+template <class T>
+auto communicator::iallgather(const T &_value, std::vector<T> &_bucket) -> std::unique_ptr<iallgather_request<std::vector<T>>>
+{
+    return iallgather(std::vector<T>{_value}, _bucket);
+}
+template <class T>
+auto communicator::iallgather(const std::vector<T> &_value, std::vector<T> &_bucket) -> std::unique_ptr<iallgather_request<std::vector<T>>>
+{
+    return std::make_unique<iallgather_request<std::vector<T>>>(_comm, _value, _bucket);
+}
+template <class T>
+auto communicator::iallgather(const T &_value) -> std::unique_ptr<iallgather_reply<std::vector<T>>>
+{
+    return iallgather(std::vector<T>{_value});
+}
+template <class T>
+auto communicator::iallgather(const std::vector<T> &_value) -> std::unique_ptr<iallgather_reply<std::vector<T>>>
+{
+    return std::make_unique<iallgather_reply<std::vector<T>>>(_comm, _value);
+}
+
+template <class T>
+auto communicator::alltoall(const T &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
+{
+    return alltoall(std::vector<T>{_value}, _bucket, _chunk_size);
+}
+template <class T>
+auto communicator::alltoall(const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
+{
+    return alltoall_impl(_comm, _value, _bucket, _chunk_size);
+}
+template <class T>
+auto communicator::alltoall(const T &_value, const size_t _chunk_size) -> std::vector<T>
+{
+    return alltoall(std::vector<T>{_value}, _chunk_size);
+}
+template <class T>
+auto communicator::alltoall(const std::vector<T> &_value, const size_t _chunk_size) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    alltoall(_value, _bucket, _chunk_size);
+    return _bucket;
+}
+template <class T>
+auto communicator::ialltoall(const T &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> std::unique_ptr<ialltoall_request<std::vector<T>>>
+{
+    return ialltoall(std::vector<T>{_value}, _bucket, _chunk_size);
+}
+template <class T>
+auto communicator::ialltoall(const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> std::unique_ptr<ialltoall_request<std::vector<T>>>
+{
+    return std::make_unique<ialltoall_request<std::vector<T>>>(_comm, _value, _bucket, _chunk_size);
+}
+template <class T>
+auto communicator::ialltoall(const T &_value, const size_t _chunk_size) -> std::unique_ptr<ialltoall_reply<std::vector<T>>>
+{
+    return ialltoall(std::vector<T>{_value}, _chunk_size);
+}
+template <class T>
+auto communicator::ialltoall(const std::vector<T> &_value, const size_t _chunk_size) -> std::unique_ptr<ialltoall_reply<std::vector<T>>>
+{
+    return std::make_unique<ialltoall_reply<std::vector<T>>>(_comm, _value, _chunk_size);
+}
+
+template <class T>
+auto communicator::allgatherv(const std::vector<T> &_value, std::vector<T> &_bucket) -> void
+{
+    return allgatherv_impl(_comm, _value, _bucket, impl::allgather_counts(_comm, _value.size()));
+}
+template <class T>
+auto communicator::allgatherv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> void
+{
+    return allgatherv_impl(_comm, _value, _bucket, impl::make_counts(_counts));
+}
+template <class T>
+auto communicator::allgatherv(const std::vector<T> &_value) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    allgatherv(_value, _bucket);
+    return _bucket;
+}
+template <class T>
+auto communicator::iallgatherv(const std::vector<T> &_value, std::vector<T> &_bucket) -> std::unique_ptr<iallgatherv_request<std::vector<T>>>
+{
+    return std::make_unique<iallgatherv_request<std::vector<T>>>(_comm, _value, _bucket, impl::allgather_counts(_comm, _value.size()));
+}
+template <class T>
+auto communicator::iallgatherv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> std::unique_ptr<iallgatherv_request<std::vector<T>>>
+{
+    return std::make_unique<iallgatherv_request<std::vector<T>>>(_comm, _value, _bucket, impl::make_counts(_counts));
+}
+
+template <class T>
+auto communicator::alltoallv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_send_counts) -> void
+{
+    return alltoallv_impl(_comm, _value, _bucket, impl::make_counts(_send_counts), impl::alltoall_counts(_comm, _send_counts));
+}
+template <class T>
+auto communicator::alltoallv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_send_counts, const std::vector<size_t> &_recv_counts) -> void
+{
+    return alltoallv_impl(_comm, _value, _bucket, impl::make_counts(_send_counts), impl::make_counts(_recv_counts));
+}
+template <class T>
+auto communicator::alltoallv(const std::vector<T> &_value, const std::vector<size_t> &_send_counts) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    alltoallv(_value, _bucket, _send_counts);
+    return _bucket;
+}
+template <class T>
+auto communicator::ialltoallv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_send_counts) -> std::unique_ptr<ialltoallv_request<std::vector<T>>>
+{
+    return std::make_unique<ialltoallv_request<std::vector<T>>>(_comm, _value, _bucket, impl::make_counts(_send_counts), impl::alltoall_counts(_comm, _send_counts));
+}
+template <class T>
+auto communicator::ialltoallv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_send_counts, const std::vector<size_t> &_recv_counts) -> std::unique_ptr<ialltoallv_request<std::vector<T>>>
+{
+    return std::make_unique<ialltoallv_request<std::vector<T>>>(_comm, _value, _bucket, impl::make_counts(_send_counts), impl::make_counts(_recv_counts));
+}
+
+template <class T>
+auto communicator::allreduce(const T &_value, T &_bucket, op *_operation) -> void
+{
+    return allreduce_impl(_comm, _value, _bucket, _operation, get_hierarchy());
+}
+template <class T>
+auto communicator::allreduce(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    return allreduce_impl(_comm, _value, _bucket, _operation, get_hierarchy());
+}
+template <class T>
+auto communicator::allreduce(const T &_value, T &_bucket, op *_operation, hierarchy _mode) -> void
+{
+    return allreduce_impl(_comm, _value, _bucket, _operation, _mode);
+}
+template <class T>
+auto communicator::allreduce(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation, hierarchy _mode) -> void
+{
+    return allreduce_impl(_comm, _value, _bucket, _operation, _mode);
+}
+template <class T>
+auto communicator::allreduce(const T &_value, op *_operation) -> T
+{
+    auto _bucket = T{};
+    allreduce(_value, _bucket, _operation);
+    return _bucket;
+}
+template <class T>
+auto communicator::allreduce(const std::vector<T> &_value, op *_operation) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    allreduce(_value, _bucket, _operation);
+    return _bucket;
+}
+
+template <class T, class Op>
+auto communicator::allreduce(const T &_value, T &_bucket, Op _operation) -> void
+{
+    return allreduce(_value, _bucket, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::allreduce(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> void
+{
+    return allreduce(_value, _bucket, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::allreduce(const T &_value, T &_bucket, Op _operation, hierarchy _mode) -> void
+{
+    return allreduce(_value, _bucket, make_op<T>(_operation).get(), _mode);
+}
+template <class T, class Op>
+auto communicator::allreduce(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation, hierarchy _mode) -> void
+{
+    return allreduce(_value, _bucket, make_op<T>(_operation).get(), _mode);
+}
+template <class Op>
+auto communicator::allreduce(const char _value, std::string &_bucket, Op _operation) -> void
+{
+    return allreduce(_value, _bucket, make_op<std::string>(_operation).get());
+}
+template <class Op>
+auto communicator::allreduce(const char *_value, std::string &_bucket, Op _operation) -> void
+{
+    return allreduce(_value, _bucket, make_op<std::string>(_operation).get());
+}
+template <class Op>
+auto communicator::allreduce(const std::string &_value, std::string &_bucket, Op _operation) -> void
+{
+    return allreduce(_value, _bucket, make_op<std::string>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::allreduce(const T &_value, Op _operation) -> T
+{
+    return allreduce(_value, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::allreduce(const std::vector<T> &_value, Op _operation) -> std::vector<T>
+{
+    return allreduce(_value, make_op<T>(_operation).get());
+}
+template <class Op>
+auto communicator::allreduce(const char _value, Op _operation) -> std::string
+{
+    return allreduce(_value, make_op<std::string>(_operation).get());
+}
+template <class Op>
+auto communicator::allreduce(const char *_value, Op _operation) -> std::string
+{
+    return allreduce(_value, make_op<std::string>(_operation).get());
+}
+template <class Op>
+auto communicator::allreduce(const std::string &_value, Op _operation) -> std::string
+{
+    return allreduce(_value, make_op<std::string>(_operation).get());
+}
+
+template <class T>
+auto communicator::iallreduce(const T &_value, T &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_request<T>>
+{
+    return std::make_unique<iallreduce_request<T>>(_comm, _value, _bucket, _operation);
+}
+template <class T>
+auto communicator::iallreduce(const std::vector<T> &_value, std::vector<T> &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_request<std::vector<T>>>
+{
+    return std::make_unique<iallreduce_request<std::vector<T>>>(_comm, _value, _bucket, _operation);
+}
+template <class T>
+auto communicator::iallreduce(const T &_value, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_reply<T>>
+{
+    return std::make_unique<iallreduce_reply<T>>(_comm, _value, _operation);
+}
+template <class T>
+auto communicator::iallreduce(const std::vector<T> &_value, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_reply<std::vector<T>>>
+{
+    return std::make_unique<iallreduce_reply<std::vector<T>>>(_comm, _value, _operation);
+}
+
+template <class T, class Op>
+auto communicator::iallreduce(const T &_value, T &_bucket, Op _operation) -> std::unique_ptr<iallreduce_request<T>>
+{
+    return iallreduce(_value, _bucket, make_op<T>(_operation));
+}
+template <class T, class Op>
+auto communicator::iallreduce(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> std::unique_ptr<iallreduce_request<std::vector<T>>>
+{
+    return iallreduce(_value, _bucket, make_op<T>(_operation));
+}
+template <class Op>
+auto communicator::iallreduce(const char _value, std::string &_bucket, Op _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+{
+    return iallreduce(_value, _bucket, make_op<std::string>(_operation));
+}
+template <class Op>
+auto communicator::iallreduce(const char *_value, std::string &_bucket, Op _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+{
+    return iallreduce(_value, _bucket, make_op<std::string>(_operation));
+}
+template <class Op>
+auto communicator::iallreduce(const std::string &_value, std::string &_bucket, Op _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+{
+    return iallreduce(_value, _bucket, make_op<std::string>(_operation));
+}
+template <class T, class Op>
+auto communicator::iallreduce(const T &_value, Op _operation) -> std::unique_ptr<iallreduce_reply<T>>
+{
+    return iallreduce(_value, make_op<T>(_operation));
+}
+template <class T, class Op>
+auto communicator::iallreduce(const std::vector<T> &_value, Op _operation) -> std::unique_ptr<iallreduce_reply<std::vector<T>>>
+{
+    return iallreduce(_value, make_op<T>(_operation));
+}
+template <class Op>
+auto communicator::iallreduce(const char _value, Op _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+{
+    return iallreduce(_value, make_op<std::string>(_operation));
+}
+template <class Op>
+auto communicator::iallreduce(const char *_value, Op _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+{
+    return iallreduce(_value, make_op<std::string>(_operation));
+}
+template <class Op>
+auto communicator::iallreduce(const std::string &_value, Op _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+{
+    return iallreduce(_value, make_op<std::string>(_operation));
+}
+
+template <class T>
+auto communicator::neighbor_allgather(const T &_value, std::vector<T> &_bucket) -> void
+{
+    return neighbor_allgather(std::vector<T>{_value}, _bucket);
+}
+template <class T>
+auto communicator::neighbor_allgather(const std::vector<T> &_value, std::vector<T> &_bucket) -> void
+{
+    return neighbor_allgather_impl(_comm, _value, _bucket);
+}
+template <class T>
+auto communicator::neighbor_allgather(const T &_value) -> std::vector<T>
+{
+    return neighbor_allgather(std::vector<T>{_value});
+}
+template <class T>
+auto communicator::neighbor_allgather(const std::vector<T> &_value) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    neighbor_allgather(_value, _bucket);
+    return _bucket;
+}
+template <class T>
+auto communicator::neighbor_alltoall(const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
+{
+    return neighbor_alltoall_impl(_comm, _value, _bucket, _chunk_size);
+}
+template <class T>
+auto communicator::neighbor_alltoall(const std::vector<T> &_value, const size_t _chunk_size) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    neighbor_alltoall(_value, _bucket, _chunk_size);
+    return _bucket;
+}
+template <class T>
+auto communicator::ineighbor_allgather(const T &_value, std::vector<T> &_bucket) -> std::unique_ptr<ineighbor_allgather_request<std::vector<T>>>
+{
+    return ineighbor_allgather(std::vector<T>{_value}, _bucket);
+}
+template <class T>
+auto communicator::ineighbor_allgather(const std::vector<T> &_value, std::vector<T> &_bucket) -> std::unique_ptr<ineighbor_allgather_request<std::vector<T>>>
+{
+    return std::make_unique<ineighbor_allgather_request<std::vector<T>>>(_comm, _value, _bucket);
+}
+template <class T>
+auto communicator::ineighbor_alltoall(const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> std::unique_ptr<ineighbor_alltoall_request<std::vector<T>>>
+{
+    return std::make_unique<ineighbor_alltoall_request<std::vector<T>>>(_comm, _value, _bucket, _chunk_size);
+}
+
+template <class T>
+auto communicator::scan(const T &_value, T &_bucket, op *_operation) -> void
+{
+    return scan_impl(_comm, _value, _bucket, _operation);
+}
+template <class T>
+auto communicator::scan(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    return scan_impl(_comm, _value, _bucket, _operation);
+}
+template <class T>
+auto communicator::scan(const T &_value, op *_operation) -> T
+{
+    auto _bucket = T{};
+    scan(_value, _bucket, _operation);
+    return _bucket;
+}
+template <class T>
+auto communicator::scan(const std::vector<T> &_value, op *_operation) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    scan(_value, _bucket, _operation);
+    return _bucket;
+}
+template <class T>
+auto communicator::exscan(const T &_value, T &_bucket, op *_operation) -> void
+{
+    return exscan_impl(_comm, _value, _bucket, _operation);
+}
+template <class T>
+auto communicator::exscan(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    return exscan_impl(_comm, _value, _bucket, _operation);
+}
+template <class T>
+auto communicator::exscan(const T &_value, op *_operation) -> T
+{
+    auto _bucket = T{};
+    exscan(_value, _bucket, _operation);
+    return _bucket;
+}
+template <class T>
+auto communicator::exscan(const std::vector<T> &_value, op *_operation) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    exscan(_value, _bucket, _operation);
+    return _bucket;
+}
+
+template <class T, class Op>
+auto communicator::scan(const T &_value, T &_bucket, Op _operation) -> void
+{
+    return scan(_value, _bucket, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::scan(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> void
+{
+    return scan(_value, _bucket, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::scan(const T &_value, Op _operation) -> T
+{
+    return scan(_value, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::scan(const std::vector<T> &_value, Op _operation) -> std::vector<T>
+{
+    return scan(_value, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::exscan(const T &_value, T &_bucket, Op _operation) -> void
+{
+    return exscan(_value, _bucket, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::exscan(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> void
+{
+    return exscan(_value, _bucket, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::exscan(const T &_value, Op _operation) -> T
+{
+    return exscan(_value, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::exscan(const std::vector<T> &_value, Op _operation) -> std::vector<T>
+{
+    return exscan(_value, make_op<T>(_operation).get());
+}
+
+template <class T>
+auto communicator::iscan(const T &_value, T &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iscan_request<T>>
+{
+    return std::make_unique<iscan_request<T>>(_comm, _value, _bucket, _operation);
+}
+template <class T>
+auto communicator::iscan(const std::vector<T> &_value, std::vector<T> &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iscan_request<std::vector<T>>>
+{
+    return std::make_unique<iscan_request<std::vector<T>>>(_comm, _value, _bucket, _operation);
+}
+template <class T, class Op>
+auto communicator::iscan(const T &_value, T &_bucket, Op _operation) -> std::unique_ptr<iscan_request<T>>
+{
+    return iscan(_value, _bucket, make_op<T>(_operation));
+}
+template <class T, class Op>
+auto communicator::iscan(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> std::unique_ptr<iscan_request<std::vector<T>>>
+{
+    return iscan(_value, _bucket, make_op<T>(_operation));
+}
+template <class T>
+auto communicator::iexscan(const T &_value, T &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iexscan_request<T>>
+{
+    return std::make_unique<iexscan_request<T>>(_comm, _value, _bucket, _operation);
+}
+template <class T>
+auto communicator::iexscan(const std::vector<T> &_value, std::vector<T> &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iexscan_request<std::vector<T>>>
+{
+    return std::make_unique<iexscan_request<std::vector<T>>>(_comm, _value, _bucket, _operation);
+}
+template <class T, class Op>
+auto communicator::iexscan(const T &_value, T &_bucket, Op _operation) -> std::unique_ptr<iexscan_request<T>>
+{
+    return iexscan(_value, _bucket, make_op<T>(_operation));
+}
+template <class T, class Op>
+auto communicator::iexscan(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> std::unique_ptr<iexscan_request<std::vector<T>>>
+{
+    return iexscan(_value, _bucket, make_op<T>(_operation));
+}
+
+template <class T>
+auto communicator::reduce_scatter(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, op *_operation) -> void
+{
+    return reduce_scatter_impl(_comm, _value, _bucket, impl::make_counts(_counts), _operation);
+}
+template <class T>
+auto communicator::reduce_scatter(const std::vector<T> &_value, const std::vector<size_t> &_counts, op *_operation) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    reduce_scatter(_value, _bucket, _counts, _operation);
+    return _bucket;
+}
+template <class T>
+auto communicator::reduce_scatter_block(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+{
+    return reduce_scatter_block_impl(_comm, _value, _bucket, _operation);
+}
+template <class T>
+auto communicator::reduce_scatter_block(const std::vector<T> &_value, op *_operation) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    reduce_scatter_block(_value, _bucket, _operation);
+    return _bucket;
+}
+template <class T, class Op>
+auto communicator::reduce_scatter(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, Op _operation) -> void
+{
+    return reduce_scatter(_value, _bucket, _counts, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::reduce_scatter(const std::vector<T> &_value, const std::vector<size_t> &_counts, Op _operation) -> std::vector<T>
+{
+    return reduce_scatter(_value, _counts, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::reduce_scatter_block(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> void
+{
+    return reduce_scatter_block(_value, _bucket, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto communicator::reduce_scatter_block(const std::vector<T> &_value, Op _operation) -> std::vector<T>
+{
+    return reduce_scatter_block(_value, make_op<T>(_operation).get());
+}
+
+template <class T>
+auto communicator::ireduce_scatter(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, std::shared_ptr<op> _operation) -> std::unique_ptr<ireduce_scatter_request<std::vector<T>>>
+{
+    return std::make_unique<ireduce_scatter_request<std::vector<T>>>(_comm, _value, _bucket, impl::make_counts(_counts), _operation);
+}
+template <class T>
+auto communicator::ireduce_scatter_block(const std::vector<T> &_value, std::vector<T> &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<ireduce_scatter_block_request<std::vector<T>>>
+{
+    return std::make_unique<ireduce_scatter_block_request<std::vector<T>>>(_comm, _value, _bucket, _operation);
+}
+template <class T, class Op>
+auto communicator::ireduce_scatter(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, Op _operation) -> std::unique_ptr<ireduce_scatter_request<std::vector<T>>>
+{
+    return ireduce_scatter(_value, _bucket, _counts, make_op<T>(_operation));
+}
+template <class T, class Op>
+auto communicator::ireduce_scatter_block(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> std::unique_ptr<ireduce_scatter_block_request<std::vector<T>>>
+{
+    return ireduce_scatter_block(_value, _bucket, make_op<T>(_operation));
+}
+
+template <class T>
+auto communicator::allgather_init(const T &_value, std::vector<T> &_bucket) -> std::unique_ptr<allgather_init_request<T>>
+{
+    _bucket.resize(size());
+    return std::make_unique<allgather_init_request<T>>(_comm, _value, _bucket);
+}
+template <class T>
+auto communicator::allgather_init(const std::vector<T> &_value, std::vector<T> &_bucket) -> std::unique_ptr<allgather_init_request<std::vector<T>>>
+{
+    _bucket.resize(_value.size() * size());
+    return std::make_unique<allgather_init_request<std::vector<T>>>(_comm, _value, _bucket);
+}
+template <class T>
+auto communicator::alltoall_init(const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> std::unique_ptr<alltoall_init_request<std::vector<T>>>
+{
+    assert((_value.size() >= _chunk_size * size()));
+    _bucket.resize(_chunk_size * size());
+    return std::make_unique<alltoall_init_request<std::vector<T>>>(_comm, _value, _bucket, _chunk_size);
+}
+template <class T>
+auto communicator::allreduce_init(const T &_value, T &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<allreduce_init_request<T>>
+{
+    return std::make_unique<allreduce_init_request<T>>(_comm, _value, _bucket, _operation);
+}
+template <class T>
+auto communicator::allreduce_init(const std::vector<T> &_value, std::vector<T> &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<allreduce_init_request<std::vector<T>>>
+{
+    _bucket.resize(_value.size());
+    return std::make_unique<allreduce_init_request<std::vector<T>>>(_comm, _value, _bucket, _operation);
+}
+template <class T, class Op>
+auto communicator::allreduce_init(const T &_value, T &_bucket, Op _operation) -> std::unique_ptr<allreduce_init_request<T>>
+{
+    return allreduce_init(_value, _bucket, make_op<T>(_operation));
+}
+template <class T, class Op>
+auto communicator::allreduce_init(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> std::unique_ptr<allreduce_init_request<std::vector<T>>>
+{
+    return allreduce_init(_value, _bucket, make_op<T>(_operation));
+}
+template <class T>
+auto communicator::allocate_shared(size_t _size) -> shared_array<T>
+{
+    return shared_array<T>{_comm, _size};
+}
+template <class T>
+auto communicator::allocate_window(size_t _size) -> window<T>
+{
+    return window<T>{_comm, _size};
+}
+template <class T>
+auto communicator::create_window(std::vector<T> &_memory) -> window<T>
+{
+    return window<T>{_comm, _memory};
+}
+#pragma endregion
+#pragma region operation wrapper
+namespace impl
+{
+template <class... T>
+auto type_key() -> const void *
+{
+    static const char _key = 0;
+    return &_key;
+}
+constexpr auto all_of(std::initializer_list<bool> _values) -> bool
+{
+    for (auto _value : _values)
+        if (!_value)
+            return false;
+    return true;
+}
+//operations without captures are empty, so the wrapper can rebuild them from their type
+template <class Op>
+struct is_stateless : std::is_empty<Op>
+{
+};
+template <class Kernel, bool Commute>
+struct is_stateless<blockwise_op<Kernel, Commute>> : is_stateless<Kernel>
+{
+};
+template <class... Op>
+struct is_stateless<std::tuple<Op...>> : std::integral_constant<bool, all_of({is_stateless<Op>::value...})>
+{
+};
+template <class Op>
+struct instance
+{
+    static auto get() -> Op
+    {
+        return lambda_hack_impl<Op>{}.get();
+    }
+};
+template <class Kernel, bool Commute>
+struct instance<blockwise_op<Kernel, Commute>>
+{
+    static auto get() -> blockwise_op<Kernel, Commute>
+    {
+        return blockwise_op<Kernel, Commute>{instance<Kernel>::get()};
+    }
+};
+template <class... Op>
+struct instance<std::tuple<Op...>>
+{
+    static auto get() -> std::tuple<Op...>
+    {
+        return std::tuple<Op...>{instance<Op>::get()...};
+    }
+};
+//elementwise form of an operation, the builtin ones are specialized in ops.h
+template <class Op>
+struct op_function
+{
+    static constexpr bool commutes = false;
+    template <class T>
+    static auto apply(Op &_op, const T &a, const T &b) -> T
+    {
+        return _op(a, b);
+    }
+};
+//block kernels can still be combined in a tuple, they are called with a range of one element there
+template <class Kernel, bool Commute>
+struct op_function<blockwise_op<Kernel, Commute>>
+{
+    static constexpr bool commutes = Commute;
+    template <class T>
+    static auto apply(blockwise_op<Kernel, Commute> &_op, const T &a, const T &b) -> T
+    {
+        auto _result = b;
+        _op._kernel(&a, &_result, size_t{1});
+        return _result;
+    }
+};
+//tuples are reduced elementwise with one operation per element
+template <class... Op>
+struct op_function<std::tuple<Op...>>
+{
+    //builtin operations commute, so the combined one does if all of its parts do
+    static constexpr bool commutes = all_of({op_function<Op>::commutes...});
+    template <class T>
+    static auto apply(std::tuple<Op...> &_op, const T &a, const T &b) -> T
+    {
+        return apply(_op, a, b, std::index_sequence_for<Op...>{});
+    }
+    template <class T, size_t... I>
+    static auto apply(std::tuple<Op...> &_op, const T &a, const T &b, std::index_sequence<I...>) -> T
+    {
+        return T{op_function<Op>::apply(std::get<I>(_op), std::get<I>(a), std::get<I>(b))...};
+    }
+};
+//reduces a whole range, a plain loop over the elementwise form lets the compiler vectorize it
+template <class Op>
+struct op_block
+{
+    template <class T>
+    static auto apply(Op &_op, const T *in, T *inout, size_t n) -> void
+    {
+        for (auto i = size_t{}; i < n; ++i)
+            inout[i] = op_function<Op>::apply(_op, in[i], inout[i]);
+    }
+};
+template <class Kernel, bool Commute>
+struct op_block<blockwise_op<Kernel, Commute>>
+{
+    template <class T>
+    static auto apply(blockwise_op<Kernel, Commute> &_op, const T *in, T *inout, size_t n) -> void
+    {
+        _op._kernel(in, inout, n);
+    }
+};
+//MPI may call an operation with any datatype built from T, so the length is converted to elements of T
+template <class T>
+auto element_count(int _len, MPI_Datatype _type) -> size_t
+{
+    auto _lower = MPI_Aint{};
+    auto _extent = MPI_Aint{};
+    MPI_Type_get_extent(_type, &_lower, &_extent);
+    paranoidly_assert((static_cast<size_t>(_extent) % sizeof(T) == 0));
+    return static_cast<size_t>(_len) * (static_cast<size_t>(_extent) / sizeof(T));
+}
+//operations without captures are shared through the cache
+template <class T, class Op>
+auto create_op(Op, const bool _commute, std::true_type) -> std::shared_ptr<op>
+{
+    //MPI_Op_create is only called for the first use of a type and operation
+    auto _key = type_key<T, Op>();
+    auto _operation = find_op(_key, _commute);
+    if (!_operation)
+    {
+        _operation = std::make_shared<op_proxy<T, Op>>(_commute);
+        register_op(_key, _commute, _operation);
+    }
+    return _operation;
+}
+//operations with captures may differ in their parameters, so every call gets its own
+template <class T, class Op>
+auto create_op(Op _func, const bool _commute, std::false_type) -> std::shared_ptr<op>
+{
+    return std::make_shared<capture_proxy<T, Op>>(std::move(_func), _commute);
+}
+} // namespace impl
+template <bool Commute, class Kernel>
+constexpr auto blockwise(Kernel _kernel) -> blockwise_op<Kernel, Commute>
+{
+    return blockwise_op<Kernel, Commute>{_kernel};
+}
+template <class T, class Op>
+auto op_proxy<T, Op>::wrapper(void *void_a, void *void_b, int *len, MPI_Datatype *type) -> void
+{
+    auto a = static_cast<const T *>(void_a);
+    auto b = static_cast<T *>(void_b);
+    auto _op = impl::instance<Op>::get();
+    impl::op_block<Op>::apply(_op, a, b, impl::element_count<T>(*len, *type));
+}
+template <class T, class Op>
+op_proxy<T, Op>::op_proxy(const bool _commute) : op(_commute || impl::op_function<Op>::commutes)
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+
+    MPI_Op_create(op_proxy<T, Op>::wrapper, this->_commute, &_operation);
+}
+template <class T, class Op>
+op_proxy<T, Op>::~op_proxy()
+{
+    release();
+}
+template <class T, class Op>
+auto op_proxy<T, Op>::release() -> void
+{
+    //the handle is already gone if ~mpi freed it
+    if (_operation == MPI_OP_NULL)
+        return;
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+
+    MPI_Op_free(&_operation);
+}
+template <class T, class Op>
+auto capture_proxy<T, Op>::wrapper(void *void_a, void *void_b, int *len, MPI_Datatype *type) -> void
+{
+    auto a = static_cast<const T *>(void_a);
+    auto b = static_cast<T *>(void_b);
+    //MPI calls the operation with the datatype of the reduction, which is the copy carrying the proxy
+    auto _proxy = static_cast<capture_proxy<T, Op> *>(nullptr);
+    auto _flag = 0;
+    MPI_Type_get_attr(*type, impl::op_keyval(), &_proxy, &_flag);
+    assert((_flag));
+    impl::op_block<Op>::apply(_proxy->_func, a, b, impl::element_count<T>(*len, *type));
+}
+template <class T, class Op>
+capture_proxy<T, Op>::capture_proxy(Op _func, const bool _commute) : op(_commute || impl::op_function<Op>::commutes), _func(std::move(_func))
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+
+    MPI_Op_create(capture_proxy<T, Op>::wrapper, this->_commute, &_operation);
+    MPI_Type_dup(type_wrapper<T>{}, &_type);
+    MPI_Type_set_attr(_type, impl::op_keyval(), this);
+}
+template <class T, class Op>
+capture_proxy<T, Op>::~capture_proxy()
+{
+    release();
+}
+template <class T, class Op>
+auto capture_proxy<T, Op>::release() -> void
+{
+    if (_operation == MPI_OP_NULL)
+        return;
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+
+    MPI_Op_free(&_operation);
+    MPI_Type_free(&_type);
+}
+
+template <class T, class Op>
+auto make_op(Op _func, const bool _commute) -> std::shared_ptr<op>
+{
+    return impl::create_op<T>(std::move(_func), _commute, impl::is_stateless<Op>{});
+}
+template <class T, class... Op>
+auto make_op(std::tuple<Op...> _func, const bool _commute) -> std::shared_ptr<op>
+{
+    static_assert(std::tuple_size<T>::value == sizeof...(Op), "every element of the tuple needs its own operation");
+    return impl::create_op<T>(std::move(_func), _commute, impl::is_stateless<std::tuple<Op...>>{});
+}
+#pragma endregion
+#pragma region reduction batch
+namespace impl
+{
+template <class T>
+typed_batch_group<T>::typed_batch_group(std::shared_ptr<op> _operation) : _operation(_operation), _round(std::make_shared<batch_round<T>>())
+{
+}
+template <class T>
+auto typed_batch_group<T>::add(const T *_data, size_t _size) -> std::pair<std::shared_ptr<batch_round<T>>, size_t>
+{
+    auto _offset = _values.size();
+    _values.insert(_values.end(), _data, _data + _size);
+    return {_round, _offset};
+}
+template <class T>
+auto typed_batch_group<T>::pending() const -> size_t
+{
+    return _values.size() * sizeof(T);
+}
+template <class T>
+auto typed_batch_group<T>::post(MPI_Comm _comm, MPI_Request *_request) -> bool
+{
+    if (_values.empty())
+        return false;
+    //the bucket is sized here, so no size negotiation is needed
+    _round->_values.resize(_values.size());
+    iallreduce_impl(_comm, _request, _values, _round->_values, _operation.get());
+    return true;
+}
+template <class T>
+auto typed_batch_group<T>::complete() -> void
+{
+    if (_values.empty())
+        return;
+    _round->_ready = true;
+    _round = std::make_shared<batch_round<T>>();
+    _values.clear();
+}
+} // namespace impl
+template <class T>
+batch_future<T>::batch_future(std::shared_ptr<impl::batch_state> _state, std::shared_ptr<impl::batch_round<T>> _round, size_t _offset) : _state(_state), _round(_round), _offset(_offset)
+{
+}
+template <class T>
+auto batch_future<T>::ready() const -> bool
+{
+    return _round->_ready;
+}
+template <class T>
+auto batch_future<T>::get() const -> T
+{
+    if (!_round->_ready)
+        _state->flush();
+    return _round->_values[_offset];
+}
+template <class T>
+batch_future<std::vector<T>>::batch_future(std::shared_ptr<impl::batch_state> _state, std::shared_ptr<impl::batch_round<T>> _round, size_t _offset, size_t _size) : _state(_state), _round(_round), _offset(_offset), _size(_size)
+{
+}
+template <class T>
+auto batch_future<std::vector<T>>::ready() const -> bool
+{
+    return _round->_ready;
+}
+template <class T>
+auto batch_future<std::vector<T>>::get() const -> std::vector<T>
+{
+    if (!_round->_ready)
+        _state->flush();
+    auto _begin = _round->_values.begin() + _offset;
+    return std::vector<T>(_begin, _begin + _size);
+}
+template <class T, class Op>
+auto reduction_batch::group(Op _operation) -> impl::typed_batch_group<T> *
+{
+    //operations with captures may differ in their parameters, so each of them gets a group of its own
+    auto _key = impl::is_stateless<Op>::value ? impl::type_key<T, Op>() : nullptr;
+    auto _found = _state->_index.find(_key);
+    if (_key && _found != _state->_index.end())
+        return static_cast<impl::typed_batch_group<T> *>(_found->second);
+    //the operation is created once per group and reused by every flush
+    auto _group = std::make_unique<impl::typed_batch_group<T>>(make_op<T>(_operation));
+    auto _result = _group.get();
+    _state->_groups.push_back(std::move(_group));
+    if (_key)
+        _state->_index[_key] = _result;
+    return _result;
+}
+template <class T, class Op>
+auto reduction_batch::allreduce(const T &_value, Op _operation) -> batch_future<T>
+{
+    auto _slot = group<T>(_operation)->add(&_value, 1);
+    auto _future = batch_future<T>{_state, _slot.first, _slot.second};
+    _state->_pending += sizeof(T);
+    if (_state->_pending >= _state->_threshold)
+        _state->flush();
+    return _future;
+}
+template <class T, class Op>
+auto reduction_batch::allreduce(const std::vector<T> &_value, Op _operation) -> batch_future<std::vector<T>>
+{
+    auto _slot = group<T>(_operation)->add(_value.data(), _value.size());
+    auto _future = batch_future<std::vector<T>>{_state, _slot.first, _slot.second, _value.size()};
+    _state->_pending += _value.size() * sizeof(T);
+    if (_state->_pending >= _state->_threshold)
+        _state->flush();
+    return _future;
+}
+#pragma endregion
+#pragma region borrowed buffer
+template <class T>
+borrowed<T>::borrowed(const T *_data, size_t _size) : _data(_data), _size(_size)
+{
+}
+template <class T>
+auto borrowed<T>::data() const -> const T *
+{
+    return _data;
+}
+template <class T>
+auto borrowed<T>::size() const -> size_t
+{
+    return _size;
+}
+template <class T>
+auto borrow(const std::vector<T> &_value) -> borrowed<T>
+{
+    return borrowed<T>{_value.data(), _value.size()};
+}
+#pragma endregion
+#pragma region views
+namespace impl
+{
+template <class T>
+auto view_type(const std::vector<int> &_shape) -> MPI_Datatype
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //MPI releases the committed types in MPI_Finalize
+    static auto _types = std::map<std::vector<int>, MPI_Datatype>{};
+    auto _found = _types.find(_shape);
+    if (_found != _types.end())
+        return _found->second;
+    //the first entry tells the kind of the shape
+    auto _type = MPI_Datatype{};
+    if (_shape[0] == 0)
+    {
+        MPI_Type_vector(_shape[1], _shape[2], _shape[3], type_wrapper<T>{}, &_type);
+    }
+    else
+    {
+        auto _dimensions = static_cast<int>(_shape.size() - 1) / 3;
+        auto _sizes = _shape.data() + 1;
+        MPI_Type_create_subarray(_dimensions, _sizes, _sizes + _dimensions, _sizes + 2 * _dimensions, MPI_ORDER_C, type_wrapper<T>{}, &_type);
+    }
+    MPI_Type_commit(&_type);
+    _types.emplace(_shape, _type);
+    return _type;
+}
+} // namespace impl
+template <class T>
+view<T>::view(T *_data, MPI_Datatype _type, int _size) : _data(_data), _type(_type), _size(_size)
+{
+}
+template <class T>
+auto view<T>::data() const -> T *
+{
+    return _data;
+}
+template <class T>
+auto view<T>::type() const -> MPI_Datatype
+{
+    return _type;
+}
+template <class T>
+auto view<T>::size() const -> int
+{
+    return _size;
+}
+template <class T>
+auto strided(T *_data, int _count, int _blocklength, int _stride) -> view<T>
+{
+    return view<T>{_data, impl::view_type<T>({0, _count, _blocklength, _stride}), _count * _blocklength};
+}
+template <class T>
+auto strided(std::vector<T> &_data, int _count, int _blocklength, int _stride, size_t _offset) -> view<T>
+{
+    //the last block has to end inside the vector
+    assert((_count == 0 || _offset + static_cast<size_t>((_count - 1) * _stride + _blocklength) <= _data.size()));
+    return strided(_data.data() + _offset, _count, _blocklength, _stride);
+}
+template <class T>
+auto column(std::vector<T> &_matrix, int _columns, int _column) -> view<T>
+{
+    assert((_column < _columns && _matrix.size() % _columns == 0));
+    return strided(_matrix, static_cast<int>(_matrix.size() / _columns), 1, _columns, _column);
+}
+template <class T>
+auto subarray(T *_data, const std::vector<int> &_sizes, const std::vector<int> &_subsizes, const std::vector<int> &_starts) -> view<T>
+{
+    assert((_sizes.size() == _subsizes.size() && _sizes.size() == _starts.size()));
+    auto _shape = std::vector<int>{1};
+    _shape.insert(_shape.end(), _sizes.begin(), _sizes.end());
+    _shape.insert(_shape.end(), _subsizes.begin(), _subsizes.end());
+    _shape.insert(_shape.end(), _starts.begin(), _starts.end());
+    auto _size = 1;
+    for (auto _subsize : _subsizes)
+        _size *= _subsize;
+    return view<T>{_data, impl::view_type<T>(_shape), _size};
+}
+template <class T>
+auto subarray(std::vector<T> &_data, const std::vector<int> &_sizes, const std::vector<int> &_subsizes, const std::vector<int> &_starts) -> view<T>
+{
+    return subarray(_data.data(), _sizes, _subsizes, _starts);
+}
+#pragma endregion
+#pragma region shared memory
+template <class T>
+shared_array<T>::shared_array(MPI_Comm _comm, size_t _size) : _size(_size)
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //the window lives on a private copy of the node, so it outlives the communicator it came from
+    MPI_Comm_dup(impl::node_info(_comm)._node, &this->_comm);
+    //only the first process allocates, everyone else maps its memory
+    auto _bytes = (local_rank() == 0) ? static_cast<MPI_Aint>(_size * sizeof(T)) : MPI_Aint{};
+    auto _base = static_cast<T *>(nullptr);
+    MPI_Win_allocate_shared(_bytes, sizeof(T), MPI_INFO_NULL, this->_comm, &_base, &_window);
+    auto _segment = MPI_Aint{};
+    auto _unit = int{};
+    MPI_Win_shared_query(_window, 0, &_segment, &_unit, &_data);
+    //one passive epoch for the whole lifetime, sync() orders the accesses
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, _window);
+}
+template <class T>
+shared_array<T>::shared_array(shared_array &&_other) : _comm(_other._comm), _window(_other._window), _data(_other._data), _size(_other._size)
+{
+    _other._comm = MPI_COMM_NULL;
+    _other._window = MPI_WIN_NULL;
+    _other._data = nullptr;
+    _other._size = 0;
+}
+template <class T>
+shared_array<T>::~shared_array()
+{
+    release();
+}
+template <class T>
+auto shared_array<T>::operator=(shared_array &&_other) -> shared_array &
+{
+    if (this == &_other)
+        return *this;
+    release();
+    std::swap(_comm, _other._comm);
+    std::swap(_window, _other._window);
+    std::swap(_data, _other._data);
+    std::swap(_size, _other._size);
+    return *this;
+}
+template <class T>
+auto shared_array<T>::release() -> void
+{
+    //the window cannot be freed anymore after MPI was finalized
+    if (_window != MPI_WIN_NULL && !finalized())
+    {
+        MPI_Win_unlock_all(_window);
+        MPI_Win_free(&_window);
+        MPI_Comm_free(&_comm);
+    }
+    _window = MPI_WIN_NULL;
+    _comm = MPI_COMM_NULL;
+    _data = nullptr;
+    _size = 0;
+}
+template <class T>
+auto shared_array<T>::operator[](size_t _index) -> T &
+{
+    return _data[_index];
+}
+template <class T>
+auto shared_array<T>::operator[](size_t _index) const -> const T &
+{
+    return _data[_index];
+}
+template <class T>
+auto shared_array<T>::data() -> T *
+{
+    return _data;
+}
+template <class T>
+auto shared_array<T>::data() const -> const T *
+{
+    return _data;
 }
-#pragma endregion
-#pragma region nonblocking gather
-//declarations
-auto igather_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket) -> void;
-//templates
 template <class T>
-auto igather_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket) -> void
+auto shared_array<T>::begin() -> T *
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //get world size
-    auto _size = comm(_comm)->size();
-    //broadcast the chunk_size before the data is gathered
-    auto _chunk_size = (_rank == _dest) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(_dest)->bcast(_chunk_size);
-    //check size
-    assert((_value.size() == _chunk_size));
-    //resize bucket to take all elements
-    if (_rank == _dest)
-    {
-        if (_size * _chunk_size != _bucket.size())
-            _bucket.resize(_size * _chunk_size);
-    }
-    //gather the data
-    MPI_Igather(_value.data(), _chunk_size, type_wrapper<T>{}, _bucket.data(), _chunk_size, type_wrapper<T>{}, _dest, _comm, _request);
+    return _data;
 }
-#pragma endregion
-#pragma region nonblocking receive
-//declarations
-auto irecv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, MPI_Request *_request, std::unique_ptr<char[]> &_value) -> void;
-//templates
 template <class T>
-auto irecv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, MPI_Request *_request, T &_value) -> void
+auto shared_array<T>::begin() const -> const T *
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-    MPI_Irecv(&_value, 1, type_wrapper<T>{}, _source, _tag, _comm, _request);
+    return _data;
 }
 template <class T>
-auto irecv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, MPI_Request *_request, std::vector<T> &_value) -> void
+auto shared_array<T>::end() -> T *
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-    //we need to find the proper size of the incoming data
-    MPI_Probe(_source, _tag, _comm, _status);
-    auto _size = int{};
-    MPI_Get_count(_status, type_wrapper<T>{}, &_size);
-    //we need to allocate some memory for it
-    _value.resize(_size);
-    //we need to receive it
-    MPI_Irecv(_value.data(), _size, type_wrapper<T>{}, _source, _tag, _comm, _request);
+    return _data + _size;
 }
-#pragma endregion
-#pragma region nonblocking reduce
-//declarations
-auto ireduce_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket, op *_operation) -> void;
-//templates
 template <class T>
-auto ireduce_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const T &_value, T &_bucket, op *_operation) -> void
+auto shared_array<T>::end() const -> const T *
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-    //reduce the data
-    MPI_Ireduce(&_value, &_bucket, 1, type_wrapper<T>{}, _operation->get(), _dest, _comm, _request);
+    return _data + _size;
 }
 template <class T>
-auto ireduce_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+auto shared_array<T>::size() const -> size_t
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the chunk_size before the data is reduced
-    auto _size = (_rank == _dest) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(_dest)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
-    //resize bucket to take all elements
-    if (_rank == _dest)
-    {
-        if (_size != _bucket.size())
-            _bucket.resize(_size);
-    }
-    //reduce the data
-    MPI_Ireduce(_value.data(), _bucket.data(), _size, type_wrapper<T>{}, _operation->get(), _dest, _comm, _request);
+    return _size;
 }
-#pragma endregion
-#pragma region nonblocking scatter
-//declarations
-auto iscatter_impl(int _source, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket, const size_t _chunk_size) -> void;
-//templates
 template <class T>
-auto iscatter_impl(int _source, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
+auto shared_array<T>::get() const -> MPI_Win
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-    //resize bucket to take all elements
-    if (_chunk_size != _bucket.size())
-        _bucket.resize(_chunk_size);
-    //scatter the data
-    MPI_Iscatter(_value.data(), _chunk_size, type_wrapper<T>{}, _bucket.data(), _chunk_size, type_wrapper<T>{}, _source, _comm, _request);
+    return _window;
 }
-#pragma endregion
-#pragma region nonblocking send
-//declarations
-auto isend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void;
-//templates
 template <class T>
-auto isend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const T &_value) -> void
+auto shared_array<T>::local_rank() const -> int
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-    MPI_Isend(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm, _request);
+    return impl::rank(_comm);
 }
 template <class T>
-auto isend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value) -> void
+auto shared_array<T>::local_size() const -> int
+{
+    return impl::size(_comm);
+}
+template <class T>
+auto shared_array<T>::sync() -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Isend(_value.data(), _value.size(), type_wrapper<T>{}, _dest, _tag, _comm, _request);
+    MPI_Win_sync(_window);
+    MPI_Barrier(_comm);
+    MPI_Win_sync(_window);
 }
 #pragma endregion
-#pragma region nonblocking synchronized send
-//declarations
-auto issend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void;
-//templates
+#pragma region one-sided
 template <class T>
-auto issend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const T &_value) -> void
+window<T>::window(MPI_Comm _comm, size_t _size) : _comm(_comm), _size(_size)
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Issend(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm, _request);
+    MPI_Win_allocate(static_cast<MPI_Aint>(_size * sizeof(T)), sizeof(T), MPI_INFO_NULL, _comm, &_data, &_window);
 }
 template <class T>
-auto issend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value) -> void
+window<T>::window(MPI_Comm _comm, std::vector<T> &_memory) : _comm(_comm), _data(_memory.data()), _size(_memory.size())
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Issend(_value.data(), _value.size(), type_wrapper<T>{}, _dest, _tag, _comm, _request);
+    MPI_Win_create(_data, static_cast<MPI_Aint>(_size * sizeof(T)), sizeof(T), MPI_INFO_NULL, _comm, &_window);
 }
-#pragma endregion
-#pragma region nonblocking ready mode send
-//declarations
-auto irsend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void;
-//templates
 template <class T>
-auto irsend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const T &_value) -> void
+window<T>::window(window &&_other) : _comm(_other._comm), _window(_other._window), _data(_other._data), _size(_other._size)
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-    MPI_Irsend(&_value, 1, type_wrapper<T>{}, _dest, _tag, _comm, _request);
+    _other._comm = MPI_COMM_NULL;
+    _other._window = MPI_WIN_NULL;
+    _other._data = nullptr;
+    _other._size = 0;
 }
 template <class T>
-auto irsend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::vector<T> &_value) -> void
+window<T>::~window()
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-    MPI_Irsend(_value.data(), _value.size(), type_wrapper<T>{}, _dest, _tag, _comm, _request);
+    release();
 }
-#pragma endregion
-
-#pragma region communicator
 template <class T>
-auto communicator::allgather(const T &_value, std::vector<T> &_bucket) -> void
+auto window<T>::operator=(window &&_other) -> window &
 {
-    return allgather(std::vector<T>{_value}, _bucket);
+    if (this == &_other)
+        return *this;
+    release();
+    std::swap(_comm, _other._comm);
+    std::swap(_window, _other._window);
+    std::swap(_data, _other._data);
+    std::swap(_size, _other._size);
+    return *this;
 }
 template <class T>
-auto communicator::allgather(const std::vector<T> &_value, std::vector<T> &_bucket) -> void
+auto window<T>::release() -> void
 {
-    return allgather_impl(_comm, _value, _bucket);
+    //the window cannot be freed anymore after MPI was finalized
+    if (_window != MPI_WIN_NULL && !finalized())
+        MPI_Win_free(&_window);
+    _window = MPI_WIN_NULL;
+    _comm = MPI_COMM_NULL;
+    _data = nullptr;
+    _size = 0;
 }
 template <class T>
-auto communicator::allgather(const T &_value) -> std::vector<T>
+auto window<T>::operator[](size_t _index) -> T &
 {
-    return allgather(std::vector<T>{_value});
+    return _data[_index];
 }
 template <class T>
-auto communicator::allgather(const std::vector<T> &_value) -> std::vector<T>
+auto window<T>::operator[](size_t _index) const -> const T &
 {
-    auto _bucket = std::vector<T>{};
-    allgather(_value, _bucket);
-    return _bucket;
+    return _data[_index];
 }
 template <class T>
-auto communicator::iallgather(const T &_value, std::vector<T> &_bucket) -> std::unique_ptr<iallgather_request<std::vector<T>>>
+auto window<T>::data() -> T *
 {
-    return iallgather(std::vector<T>{_value}, _bucket);
+    return _data;
 }
 template <class T>
-auto communicator::iallgather(const std::vector<T> &_value, std::vector<T> &_bucket) -> std::unique_ptr<iallgather_request<std::vector<T>>>
+auto window<T>::data() const -> const T *
 {
-    return std::make_unique<iallgather_request<std::vector<T>>>(_comm, _value, _bucket);
+    return _data;
 }
 template <class T>
-auto communicator::iallgather(const T &_value) -> std::unique_ptr<iallgather_reply<std::vector<T>>>
+auto window<T>::size() const -> size_t
 {
-    return iallgather(std::vector<T>{_value});
+    return _size;
 }
 template <class T>
-auto communicator::iallgather(const std::vector<T> &_value) -> std::unique_ptr<iallgather_reply<std::vector<T>>>
+auto window<T>::get() const -> MPI_Win
 {
-    return std::make_unique<iallgather_reply<std::vector<T>>>(_comm, _value);
+    return _window;
 }
 
 template <class T>
-auto communicator::alltoall(const T &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
+auto window<T>::fence(int _assert) -> void
 {
-    return alltoall(std::vector<T>{_value}, _bucket, _chunk_size);
+    MPI_Win_fence(_assert, _window);
 }
 template <class T>
-auto communicator::alltoall(const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> void
+auto window<T>::lock(int _target, lock_type _type, int _assert) -> void
 {
-    return alltoall_impl(_comm, _value, _bucket, _chunk_size);
+    MPI_Win_lock((_type == lock_type::exclusive) ? MPI_LOCK_EXCLUSIVE : MPI_LOCK_SHARED, _target, _assert, _window);
 }
 template <class T>
-auto communicator::alltoall(const T &_value, const size_t _chunk_size) -> std::vector<T>
+auto window<T>::unlock(int _target) -> void
 {
-    return alltoall(std::vector<T>{_value}, _chunk_size);
+    MPI_Win_unlock(_target, _window);
 }
 template <class T>
-auto communicator::alltoall(const std::vector<T> &_value, const size_t _chunk_size) -> std::vector<T>
+auto window<T>::lock_all(int _assert) -> void
 {
-    auto _bucket = std::vector<T>{};
-    alltoall(_value, _bucket, _chunk_size);
-    return _bucket;
+    MPI_Win_lock_all(_assert, _window);
 }
 template <class T>
-auto communicator::ialltoall(const T &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> std::unique_ptr<ialltoall_request<std::vector<T>>>
+auto window<T>::unlock_all() -> void
 {
-    return ialltoall(std::vector<T>{_value}, _bucket, _chunk_size);
+    MPI_Win_unlock_all(_window);
 }
 template <class T>
-auto communicator::ialltoall(const std::vector<T> &_value, std::vector<T> &_bucket, const size_t _chunk_size) -> std::unique_ptr<ialltoall_request<std::vector<T>>>
+auto window<T>::flush(int _target) -> void
 {
-    return std::make_unique<ialltoall_request<std::vector<T>>>(_comm, _value, _bucket, _chunk_size);
+    MPI_Win_flush(_target, _window);
 }
 template <class T>
-auto communicator::ialltoall(const T &_value, const size_t _chunk_size) -> std::unique_ptr<ialltoall_reply<std::vector<T>>>
+auto window<T>::flush_all() -> void
 {
-    return ialltoall(std::vector<T>{_value}, _chunk_size);
+    MPI_Win_flush_all(_window);
 }
 template <class T>
-auto communicator::ialltoall(const std::vector<T> &_value, const size_t _chunk_size) -> std::unique_ptr<ialltoall_reply<std::vector<T>>>
+auto window<T>::flush_local(int _target) -> void
 {
-    return std::make_unique<ialltoall_reply<std::vector<T>>>(_comm, _value, _chunk_size);
+    MPI_Win_flush_local(_target, _window);
+}
+template <class T>
+auto window<T>::flush_local_all() -> void
+{
+    MPI_Win_flush_local_all(_window);
+}
+template <class T>
+auto window<T>::sync() -> void
+{
+    MPI_Win_sync(_window);
 }
 
 template <class T>
-auto communicator::allreduce(const T &_value, T &_bucket, op *_operation) -> void
+auto window<T>::put(const T &_value, int _target, size_t _offset) -> void
 {
-    return allreduce_impl(_comm, _value, _bucket, _operation);
+    put_impl(_target, static_cast<MPI_Aint>(_offset), _window, _value);
 }
 template <class T>
-auto communicator::allreduce(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
+auto window<T>::put(const std::vector<T> &_value, int _target, size_t _offset) -> void
 {
-    return allreduce_impl(_comm, _value, _bucket, _operation);
+    put_impl(_target, static_cast<MPI_Aint>(_offset), _window, _value);
 }
 template <class T>
-auto communicator::allreduce(const T &_value, op *_operation) -> T
+auto window<T>::get(T &_bucket, int _target, size_t _offset) -> void
 {
-    auto _bucket = T{};
-    allreduce(_value, _bucket, _operation);
-    return _bucket;
+    get_impl(_target, static_cast<MPI_Aint>(_offset), _window, _bucket);
 }
 template <class T>
-auto communicator::allreduce(const std::vector<T> &_value, op *_operation) -> std::vector<T>
+auto window<T>::get(std::vector<T> &_bucket, int _target, size_t _offset) -> void
 {
-    auto _bucket = std::vector<T>{};
-    allreduce(_value, _bucket, _operation);
-    return _bucket;
+    get_impl(_target, static_cast<MPI_Aint>(_offset), _window, _bucket);
 }
 
-template <class T, class Op>
-auto communicator::allreduce(const T &_value, T &_bucket, Op _operation) -> void
+template <class T>
+template <class Op>
+auto window<T>::accumulate(const T &_value, int _target, size_t _offset, Op _operation) -> void
 {
-    return allreduce(_value, _bucket, make_op<T>(_operation).get());
+    accumulate_impl(_target, static_cast<MPI_Aint>(_offset), _window, &_value, 1, make_op<T>(_operation)->get());
 }
-template <class T, class Op>
-auto communicator::allreduce(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> void
+template <class T>
+template <class Op>
+auto window<T>::accumulate(const std::vector<T> &_value, int _target, size_t _offset, Op _operation) -> void
 {
-    return allreduce(_value, _bucket, make_op<T>(_operation).get());
+    accumulate_impl(_target, static_cast<MPI_Aint>(_offset), _window, _value.data(), _value.size(), make_op<T>(_operation)->get());
 }
+template <class T>
 template <class Op>
-auto communicator::allreduce(const char _value, std::string &_bucket, Op _operation) -> void
+auto window<T>::get_accumulate(const T &_value, T &_bucket, int _target, size_t _offset, Op _operation) -> void
 {
-    return allreduce(_value, _bucket, make_op<std::string>(_operation).get());
+    get_accumulate_impl(_target, static_cast<MPI_Aint>(_offset), _window, &_value, &_bucket, 1, make_op<T>(_operation)->get());
 }
+template <class T>
 template <class Op>
-auto communicator::allreduce(const char *_value, std::string &_bucket, Op _operation) -> void
+auto window<T>::get_accumulate(const std::vector<T> &_value, std::vector<T> &_bucket, int _target, size_t _offset, Op _operation) -> void
 {
-    return allreduce(_value, _bucket, make_op<std::string>(_operation).get());
+    //resize bucket to take all elements
+    if (_value.size() != _bucket.size())
+        _bucket.resize(_value.size());
+    get_accumulate_impl(_target, static_cast<MPI_Aint>(_offset), _window, _value.data(), _bucket.data(), _value.size(), make_op<T>(_operation)->get());
 }
+template <class T>
 template <class Op>
-auto communicator::allreduce(const std::string &_value, std::string &_bucket, Op _operation) -> void
+auto window<T>::fetch_and_op(const T &_value, T &_bucket, int _target, size_t _offset, Op _operation) -> void
 {
-    return allreduce(_value, _bucket, make_op<std::string>(_operation).get());
+    MPI_Fetch_and_op(&_value, &_bucket, type_wrapper<T>{}, _target, static_cast<MPI_Aint>(_offset), make_op<T>(_operation)->get(), _window);
 }
-template <class T, class Op>
-auto communicator::allreduce(const T &_value, Op _operation) -> T
+template <class T>
+auto window<T>::compare_and_swap(const T &_value, const T &_compare, T &_bucket, int _target, size_t _offset) -> void
 {
-    return allreduce(_value, make_op<T>(_operation).get());
+    MPI_Compare_and_swap(&_value, &_compare, &_bucket, type_wrapper<T>{}, _target, static_cast<MPI_Aint>(_offset), _window);
 }
-template <class T, class Op>
-auto communicator::allreduce(const std::vector<T> &_value, Op _operation) -> std::vector<T>
+
+template <class T>
+auto window<T>::rput(const T &_value, int _target, size_t _offset) -> std::unique_ptr<rput_request<T>>
 {
-    return allreduce(_value, make_op<T>(_operation).get());
+    return std::make_unique<rput_request<T>>(_target, static_cast<MPI_Aint>(_offset), _window, _comm, _value);
 }
-template <class Op>
-auto communicator::allreduce(const char _value, Op _operation) -> std::string
+template <class T>
+auto window<T>::rput(const std::vector<T> &_value, int _target, size_t _offset) -> std::unique_ptr<rput_request<std::vector<T>>>
 {
-    return allreduce(_value, make_op<std::string>(_operation).get());
+    return std::make_unique<rput_request<std::vector<T>>>(_target, static_cast<MPI_Aint>(_offset), _window, _comm, _value);
 }
-template <class Op>
-auto communicator::allreduce(const char *_value, Op _operation) -> std::string
+template <class T>
+auto window<T>::rput(std::vector<T> &&_value, int _target, size_t _offset) -> std::unique_ptr<rput_request<std::vector<T>>>
 {
-    return allreduce(_value, make_op<std::string>(_operation).get());
+    return std::make_unique<rput_request<std::vector<T>>>(_target, static_cast<MPI_Aint>(_offset), _window, _comm, std::move(_value));
 }
-template <class Op>
-auto communicator::allreduce(const std::string &_value, Op _operation) -> std::string
+template <class T>
+auto window<T>::rget(T &_bucket, int _target, size_t _offset) -> std::unique_ptr<rget_request<T>>
 {
-    return allreduce(_value, make_op<std::string>(_operation).get());
+    return std::make_unique<rget_request<T>>(_target, static_cast<MPI_Aint>(_offset), _window, _comm, _bucket);
 }
-
 template <class T>
-auto communicator::iallreduce(const T &_value, T &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_request<T>>
+auto window<T>::rget(std::vector<T> &_bucket, int _target, size_t _offset) -> std::unique_ptr<rget_request<std::vector<T>>>
 {
-    return std::make_unique<iallreduce_request<T>>(_comm, _value, _bucket, _operation);
+    return std::make_unique<rget_request<std::vector<T>>>(_target, static_cast<MPI_Aint>(_offset), _window, _comm, _bucket);
 }
+#pragma endregion
+#pragma region request implementations
 template <class T>
-auto communicator::iallreduce(const std::vector<T> &_value, std::vector<T> &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_request<std::vector<T>>>
+isend_request<T>::isend_request(int _dest, int _tag, MPI_Comm _comm, T _value) : request(_comm), _dest(_dest), _tag(_tag), _value(std::move(_value))
 {
-    return std::make_unique<iallreduce_request<std::vector<T>>>(_comm, _value, _bucket, _operation);
+    isend_impl(this->_dest, this->_tag, this->_comm, this->_handle, this->_value);
 }
 template <class T>
-auto communicator::iallreduce(const T &_value, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_reply<T>>
+issend_request<T>::issend_request(int _dest, int _tag, MPI_Comm _comm, T _value) : request(_comm), _dest(_dest), _tag(_tag), _value(std::move(_value))
 {
-    return std::make_unique<iallreduce_reply<T>>(_comm, _value, _operation);
+    issend_impl(this->_dest, this->_tag, this->_comm, this->_handle, this->_value);
 }
 template <class T>
-auto communicator::iallreduce(const std::vector<T> &_value, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_reply<std::vector<T>>>
+irsend_request<T>::irsend_request(int _dest, int _tag, MPI_Comm _comm, T _value) : request(_comm), _dest(_dest), _tag(_tag), _value(std::move(_value))
 {
-    return std::make_unique<iallreduce_reply<std::vector<T>>>(_comm, _value, _operation);
+    irsend_impl(this->_dest, this->_tag, this->_comm, this->_handle, this->_value);
 }
-
-template <class T, class Op>
-auto communicator::iallreduce(const T &_value, T &_bucket, Op _operation) -> std::unique_ptr<iallreduce_request<T>>
+template <class T>
+rput_request<T>::rput_request(int _target, MPI_Aint _offset, MPI_Win _window, MPI_Comm _comm, T _value) : request(_comm), _target(_target), _offset(_offset), _window(_window), _value(std::move(_value))
 {
-    return iallreduce(_value, _bucket, make_op<T>(_operation));
+    rput_impl(this->_target, this->_offset, this->_window, this->_handle, this->_value);
 }
-template <class T, class Op>
-auto communicator::iallreduce(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> std::unique_ptr<iallreduce_request<std::vector<T>>>
+template <class T>
+rget_request<T>::rget_request(int _target, MPI_Aint _offset, MPI_Win _window, MPI_Comm _comm, T &_bucket) : request(_comm), _target(_target), _offset(_offset), _window(_window), _bucket(_bucket)
 {
-    return iallreduce(_value, _bucket, make_op<T>(_operation));
+    rget_impl(this->_target, this->_offset, this->_window, this->_handle, this->_bucket);
 }
-template <class Op>
-auto communicator::iallreduce(const char _value, std::string &_bucket, Op _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+template <class T>
+irecv_request<T>::irecv_request(int _source, int _tag, MPI_Comm _comm, T &_value) : request(_comm), _source(_source), _tag(_tag), _bucket(_value)
 {
-    return iallreduce(_value, _bucket, make_op<std::string>(_operation));
+    if (!this->post(false))
+        impl::receive_queue::push(this, this->_comm, this->_source, this->_tag);
 }
-template <class Op>
-auto communicator::iallreduce(const char *_value, std::string &_bucket, Op _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+template <class T>
+auto irecv_request<T>::post(const bool _blocking) -> bool
 {
-    return iallreduce(_value, _bucket, make_op<std::string>(_operation));
+    if (!this->is_posted && impl::receive_queue::is_next(this, this->_comm, this->_source, this->_tag, _blocking))
+    {
+        irecv_impl(this->_source, this->_tag, this->_comm, &this->_status, this->_handle, this->_bucket);
+        this->is_posted = true;
+        impl::receive_queue::pop(this);
+    }
+    return this->is_posted;
 }
-template <class Op>
-auto communicator::iallreduce(const std::string &_value, std::string &_bucket, Op _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+template <class T>
+irecv_request<view<T>>::irecv_request(int _source, int _tag, MPI_Comm _comm, view<T> _value) : request(_comm), _source(_source), _tag(_tag), _bucket(_value)
 {
-    return iallreduce(_value, _bucket, make_op<std::string>(_operation));
+    if (!this->post(false))
+        impl::receive_queue::push(this, this->_comm, this->_source, this->_tag);
 }
-template <class T, class Op>
-auto communicator::iallreduce(const T &_value, Op _operation) -> std::unique_ptr<iallreduce_reply<T>>
+template <class T>
+auto irecv_request<view<T>>::post(const bool _blocking) -> bool
 {
-    return iallreduce(_value, make_op<T>(_operation));
+    if (!this->is_posted && impl::receive_queue::is_next(this, this->_comm, this->_source, this->_tag, _blocking))
+    {
+        irecv_impl(this->_source, this->_tag, this->_comm, &this->_status, this->_handle, this->_bucket);
+        this->is_posted = true;
+        impl::receive_queue::pop(this);
+    }
+    return this->is_posted;
 }
-template <class T, class Op>
-auto communicator::iallreduce(const std::vector<T> &_value, Op _operation) -> std::unique_ptr<iallreduce_reply<std::vector<T>>>
+template <class T>
+irecv_reply<T>::irecv_reply(int _source, int _tag, MPI_Comm _comm) : request(_comm), _source(_source), _tag(_tag), _bucket(T{})
 {
-    return iallreduce(_value, make_op<T>(_operation));
+    if (!this->post(false))
+        impl::receive_queue::push(this, this->_comm, this->_source, this->_tag);
 }
-template <class Op>
-auto communicator::iallreduce(const char _value, Op _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+template <class T>
+auto irecv_reply<T>::post(const bool _blocking) -> bool
 {
-    return iallreduce(_value, make_op<std::string>(_operation));
+    if (!this->is_posted && impl::receive_queue::is_next(this, this->_comm, this->_source, this->_tag, _blocking))
+    {
+        irecv_impl(this->_source, this->_tag, this->_comm, &this->_status, this->_handle, this->_bucket);
+        this->is_posted = true;
+        impl::receive_queue::pop(this);
+    }
+    return this->is_posted;
 }
-template <class Op>
-auto communicator::iallreduce(const char *_value, Op _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+template <class T>
+auto irecv_reply<T>::get() -> T
+{
+    this->wait();
+    return _bucket;
+}
+template <class T>
+irecv_request<std::vector<T>>::irecv_request(int _source, int _tag, MPI_Comm _comm, std::vector<T> &_value) : request(_comm), _source(_source), _tag(_tag), _message(MPI_MESSAGE_NULL), _bucket(_value)
+{
+    if (!this->post(false))
+        impl::receive_queue::push(this, this->_comm, this->_source, this->_tag);
+}
+template <class T>
+auto irecv_request<std::vector<T>>::post(const bool _blocking) -> bool
+{
+    if (!this->is_posted && impl::receive_queue::is_next(this, this->_comm, this->_source, this->_tag, _blocking) && improbe_impl(this->_source, this->_tag, this->_comm, &this->_message, &this->_status, _blocking))
+    {
+        irecv_impl(&this->_message, &this->_status, this->_handle, this->_bucket, this->_packed, impl::is_serialized<std::vector<T>>{});
+        this->is_posted = true;
+        impl::receive_queue::pop(this);
+    }
+    return this->is_posted;
+}
+template <class T>
+auto irecv_request<std::vector<T>>::complete() -> void
 {
-    return iallreduce(_value, make_op<std::string>(_operation));
+    impl::unpack(this->_packed, this->_bucket, impl::is_serialized<std::vector<T>>{});
 }
-template <class Op>
-auto communicator::iallreduce(const std::string &_value, Op _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+template <class T>
+irecv_packed_request<T>::irecv_packed_request(int _source, int _tag, MPI_Comm _comm, T &_value) : request(_comm), _source(_source), _tag(_tag), _message(MPI_MESSAGE_NULL), _bucket(_value)
 {
-    return iallreduce(_value, make_op<std::string>(_operation));
+    if (!this->post(false))
+        impl::receive_queue::push(this, this->_comm, this->_source, this->_tag);
 }
-#pragma endregion
-#pragma region operation wrapper
-template <class T, class Op>
-auto op_proxy<T, Op>::wrapper(void *void_a, void *void_b, int *len, MPI_Datatype *) -> void
+template <class T>
+auto irecv_packed_request<T>::post(const bool _blocking) -> bool
 {
-    auto a = static_cast<T *>(void_a);
-    auto b = static_cast<T *>(void_b);
-    auto op = impl::lambda_hack_impl<Op>{}.get();
-    std::transform(a, a + *len, b, b, op);
+    if (!this->is_posted && impl::receive_queue::is_next(this, this->_comm, this->_source, this->_tag, _blocking) && improbe_impl(this->_source, this->_tag, this->_comm, &this->_message, &this->_status, _blocking))
+    {
+        irecv_impl(&this->_message, &this->_status, this->_handle, this->_packed);
+        this->is_posted = true;
+        impl::receive_queue::pop(this);
+    }
+    return this->is_posted;
 }
-template <class T, class Op>
-op_proxy<T, Op>::op_proxy(const bool _commute) : op(_commute)
+template <class T>
+auto irecv_packed_request<T>::complete() -> void
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-
-    MPI_Op_create(op_proxy<T, Op>::wrapper, _commute, &_operation);
+    this->_packed.unpack(this->_bucket);
 }
-template <class T, class Op>
-op_proxy<T, Op>::~op_proxy()
+template <class T>
+irecv_reply<std::vector<T>>::irecv_reply(int _source, int _tag, MPI_Comm _comm) : request(_comm), _source(_source), _tag(_tag), _message(MPI_MESSAGE_NULL), _bucket(std::vector<T>{})
 {
-    paranoidly_assert((initialized()));
-    paranoidly_assert((!finalized()));
-
-    MPI_Op_free(&_operation);
+    if (!this->post(false))
+        impl::receive_queue::push(this, this->_comm, this->_source, this->_tag);
 }
-
-template <class T, class Op>
-auto make_op(Op _func, const bool _commute) -> std::shared_ptr<op>
+template <class T>
+auto irecv_reply<std::vector<T>>::post(const bool _blocking) -> bool
 {
-    return std::make_shared<op_proxy<T, Op>>(_commute);
+    if (!this->is_posted && impl::receive_queue::is_next(this, this->_comm, this->_source, this->_tag, _blocking) && improbe_impl(this->_source, this->_tag, this->_comm, &this->_message, &this->_status, _blocking))
+    {
+        irecv_impl(&this->_message, &this->_status, this->_handle, this->_bucket, this->_packed, impl::is_serialized<std::vector<T>>{});
+        this->is_posted = true;
+        impl::receive_queue::pop(this);
+    }
+    return this->is_posted;
 }
-#pragma endregion
-#pragma region request implementations
 template <class T>
-isend_request<T>::isend_request(int _dest, int _tag, MPI_Comm _comm, const T &_value) : request(_comm), _dest(_dest), _tag(_tag), _value(_value)
+auto irecv_reply<std::vector<T>>::complete() -> void
 {
-    isend_impl(this->_dest, this->_tag, this->_comm, &this->_request, this->_value);
+    impl::unpack(this->_packed, this->_bucket, impl::is_serialized<std::vector<T>>{});
 }
 template <class T>
-issend_request<T>::issend_request(int _dest, int _tag, MPI_Comm _comm, const T &_value) : request(_comm), _dest(_dest), _tag(_tag), _value(_value)
+auto irecv_reply<std::vector<T>>::get() -> std::vector<T>
 {
-    issend_impl(this->_dest, this->_tag, this->_comm, &this->_request, this->_value);
+    this->wait();
+    return _bucket;
 }
 template <class T>
-irsend_request<T>::irsend_request(int _dest, int _tag, MPI_Comm _comm, const T &_value) : request(_comm), _dest(_dest), _tag(_tag), _value(_value)
+irecv_packed_reply<T>::irecv_packed_reply(int _source, int _tag, MPI_Comm _comm) : request(_comm), _source(_source), _tag(_tag), _message(MPI_MESSAGE_NULL), _bucket(T{})
 {
-    irsend_impl(this->_dest, this->_tag, this->_comm, &this->_request, _value);
+    if (!this->post(false))
+        impl::receive_queue::push(this, this->_comm, this->_source, this->_tag);
 }
 template <class T>
-irecv_request<T>::irecv_request(int _source, int _tag, MPI_Comm _comm, T &_value) : request(_comm), _source(_source), _tag(_tag)
+auto irecv_packed_reply<T>::post(const bool _blocking) -> bool
 {
-    irecv_impl(this->_source, this->_tag, this->_comm, &this->_status, &this->_request, _value);
+    if (!this->is_posted && impl::receive_queue::is_next(this, this->_comm, this->_source, this->_tag, _blocking) && improbe_impl(this->_source, this->_tag, this->_comm, &this->_message, &this->_status, _blocking))
+    {
+        irecv_impl(&this->_message, &this->_status, this->_handle, this->_packed);
+        this->is_posted = true;
+        impl::receive_queue::pop(this);
+    }
+    return this->is_posted;
 }
 template <class T>
-irecv_reply<T>::irecv_reply(int _source, int _tag, MPI_Comm _comm) : request(_comm), _source(_source), _tag(_tag), _bucket(T{})
+auto irecv_packed_reply<T>::complete() -> void
 {
-    irecv_impl(this->_source, this->_tag, this->_comm, &this->_status, &this->_request, this->_bucket);
+    this->_packed.unpack(this->_bucket);
 }
 template <class T>
-auto irecv_reply<T>::get() -> T
+auto irecv_packed_reply<T>::get() -> T
 {
     this->wait();
     return _bucket;
@@ -1054,12 +3814,12 @@ auto irecv_reply<T>::get() -> T
 template <class T>
 ibcast_request<T>::ibcast_request(int _source, MPI_Comm _comm, T &_value) : request(_comm), _source(_source)
 {
-    ibcast_impl(this->_source, this->_comm, &this->_request, _value);
+    ibcast_impl(this->_source, this->_comm, this->_handle, _value);
 }
 template <class T>
 ibcast_reply<T>::ibcast_reply(int _source, MPI_Comm _comm, const T &_value) : request(_comm), _source(_source), _bucket(_value)
 {
-    ibcast_impl(this->_source, this->_comm, &this->_request, this->_bucket);
+    ibcast_impl(this->_source, this->_comm, this->_handle, this->_bucket);
 }
 template <class T>
 auto ibcast_reply<T>::get() -> T
@@ -1071,12 +3831,12 @@ auto ibcast_reply<T>::get() -> T
 template <class T>
 iscatter_request<T>::iscatter_request(int _source, MPI_Comm _comm, const T &_value, T &_bucket, const size_t _chunk_size) : request(_comm), _source(_source), _chunk_size(_chunk_size), _value(_value), _bucket(_bucket)
 {
-    iscatter_impl(this->_source, this->_comm, &this->_request, this->_value, this->_bucket, this->_chunk_size);
+    iscatter_impl(this->_source, this->_comm, this->_handle, this->_value, this->_bucket, this->_chunk_size);
 }
 template <class T>
 iscatter_reply<T>::iscatter_reply(int _source, MPI_Comm _comm, const T &_value, const size_t _chunk_size) : request(_comm), _source(_source), _chunk_size(_chunk_size), _value(_value), _bucket(T{})
 {
-    iscatter_impl(this->_source, this->_comm, &this->_request, this->_value, this->_bucket, this->_chunk_size);
+    iscatter_impl(this->_source, this->_comm, this->_handle, this->_value, this->_bucket, this->_chunk_size);
 }
 template <class T>
 auto iscatter_reply<T>::get() -> T
@@ -1088,12 +3848,12 @@ auto iscatter_reply<T>::get() -> T
 template <class T>
 igather_request<T>::igather_request(int _dest, MPI_Comm _comm, const T &_value, T &_bucket) : request(_comm), _dest(_dest), _value(_value), _bucket(_bucket)
 {
-    igather_impl(this->_dest, this->_comm, &this->_request, this->_value, this->_bucket);
+    igather_impl(this->_dest, this->_comm, this->_handle, this->_value, this->_bucket);
 }
 template <class T>
 igather_reply<T>::igather_reply(int _dest, MPI_Comm _comm, const T &_value) : request(_comm), _dest(_dest), _value(_value), _bucket(T{})
 {
-    igather_impl(this->_dest, this->_comm, &this->_request, this->_value, this->_bucket);
+    igather_impl(this->_dest, this->_comm, this->_handle, this->_value, this->_bucket);
 }
 template <class T>
 auto igather_reply<T>::get() -> T
@@ -1105,12 +3865,12 @@ auto igather_reply<T>::get() -> T
 template <class T>
 iallgather_request<T>::iallgather_request(MPI_Comm _comm, const T &_value, T &_bucket) : request(_comm), _value(_value), _bucket(_bucket)
 {
-    iallgather_impl(this->_comm, &this->_request, this->_value, this->_bucket);
+    iallgather_impl(this->_comm, this->_handle, this->_value, this->_bucket);
 }
 template <class T>
 iallgather_reply<T>::iallgather_reply(MPI_Comm _comm, const T &_value) : request(_comm), _value(_value), _bucket(T{})
 {
-    iallgather_impl(this->_comm, &this->_request, this->_value, this->_bucket);
+    iallgather_impl(this->_comm, this->_handle, this->_value, this->_bucket);
 }
 template <class T>
 auto iallgather_reply<T>::get() -> T
@@ -1122,12 +3882,12 @@ auto iallgather_reply<T>::get() -> T
 template <class T>
 ialltoall_request<T>::ialltoall_request(MPI_Comm _comm, const T &_value, T &_bucket, const size_t _chunk_size) : request(_comm), _chunk_size(_chunk_size), _value(_value), _bucket(_bucket)
 {
-    ialltoall_impl(this->_comm, &this->_request, this->_value, this->_bucket, this->_chunk_size);
+    ialltoall_impl(this->_comm, this->_handle, this->_value, this->_bucket, this->_chunk_size);
 }
 template <class T>
 ialltoall_reply<T>::ialltoall_reply(MPI_Comm _comm, const T &_value, const size_t _chunk_size) : request(_comm), _chunk_size(_chunk_size), _value(_value), _bucket(T{})
 {
-    ialltoall_impl(this->_comm, &this->_request, this->_value, this->_bucket, this->_chunk_size);
+    ialltoall_impl(this->_comm, this->_handle, this->_value, this->_bucket, this->_chunk_size);
 }
 template <class T>
 auto ialltoall_reply<T>::get() -> T
@@ -1136,15 +3896,36 @@ auto ialltoall_reply<T>::get() -> T
     return _bucket;
 }
 
+template <class T>
+iallgatherv_request<T>::iallgatherv_request(MPI_Comm _comm, const T &_value, T &_bucket, impl::v_counts &&_counts) : request(_comm), _counts(std::move(_counts)), _value(_value)
+{
+    iallgatherv_impl(this->_comm, this->_handle, this->_value, _bucket, this->_counts);
+}
+template <class T>
+ialltoallv_request<T>::ialltoallv_request(MPI_Comm _comm, const T &_value, T &_bucket, impl::v_counts &&_send_counts, impl::v_counts &&_recv_counts) : request(_comm), _send_counts(std::move(_send_counts)), _recv_counts(std::move(_recv_counts)), _value(_value)
+{
+    ialltoallv_impl(this->_comm, this->_handle, this->_value, _bucket, this->_send_counts, this->_recv_counts);
+}
+template <class T>
+igatherv_request<T>::igatherv_request(int _dest, MPI_Comm _comm, const T &_value, T &_bucket, impl::v_counts &&_counts) : request(_comm), _dest(_dest), _counts(std::move(_counts)), _value(_value)
+{
+    igatherv_impl(this->_dest, this->_comm, this->_handle, this->_value, _bucket, this->_counts);
+}
+template <class T>
+iscatterv_request<T>::iscatterv_request(int _source, MPI_Comm _comm, const T &_value, T &_bucket, impl::v_counts &&_counts, const size_t _chunk_size) : request(_comm), _source(_source), _counts(std::move(_counts)), _value(_value)
+{
+    iscatterv_impl(this->_source, this->_comm, this->_handle, this->_value, _bucket, this->_counts, _chunk_size);
+}
+
 template <class T>
 ireduce_request<T>::ireduce_request(int _dest, MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _dest(_dest), _value(_value), _bucket(_bucket)
 {
-    ireduce_impl(this->_dest, this->_comm, &this->_request, this->_value, this->_bucket, this->_operation.get());
+    ireduce_impl(this->_dest, this->_comm, this->_handle, this->_value, this->_bucket, this->_operation.get());
 }
 template <class T>
 ireduce_reply<T>::ireduce_reply(int _dest, MPI_Comm _comm, const T &_value, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _dest(_dest), _value(_value), _bucket(T{})
 {
-    ireduce_impl(this->_dest, this->_comm, &this->_request, this->_value, this->_bucket, this->_operation.get());
+    ireduce_impl(this->_dest, this->_comm, this->_handle, this->_value, this->_bucket, this->_operation.get());
 }
 template <class T>
 auto ireduce_reply<T>::get() -> T
@@ -1156,12 +3937,12 @@ auto ireduce_reply<T>::get() -> T
 template <class T>
 iallreduce_request<T>::iallreduce_request(MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _value(_value), _bucket(_bucket)
 {
-    iallreduce_impl(this->_comm, &this->_request, this->_value, this->_bucket, this->_operation.get());
+    iallreduce_impl(this->_comm, this->_handle, this->_value, this->_bucket, this->_operation.get());
 }
 template <class T>
 iallreduce_reply<T>::iallreduce_reply(MPI_Comm _comm, const T &_value, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _value(_value), _bucket(T{})
 {
-    iallreduce_impl(this->_comm, &this->_request, this->_value, this->_bucket, this->_operation.get());
+    iallreduce_impl(this->_comm, this->_handle, this->_value, this->_bucket, this->_operation.get());
 }
 template <class T>
 auto iallreduce_reply<T>::get() -> T
@@ -1169,6 +3950,162 @@ auto iallreduce_reply<T>::get() -> T
     this->wait();
     return _bucket;
 }
+
+template <class T>
+ineighbor_allgather_request<T>::ineighbor_allgather_request(MPI_Comm _comm, const T &_value, T &_bucket) : request(_comm), _value(_value), _bucket(_bucket)
+{
+    ineighbor_allgather_impl(this->_comm, this->_handle, this->_value, this->_bucket);
+}
+template <class T>
+ineighbor_alltoall_request<T>::ineighbor_alltoall_request(MPI_Comm _comm, const T &_value, T &_bucket, const size_t _chunk_size) : request(_comm), _chunk_size(_chunk_size), _value(_value), _bucket(_bucket)
+{
+    ineighbor_alltoall_impl(this->_comm, this->_handle, this->_value, this->_bucket, this->_chunk_size);
+}
+template <class T>
+iscan_request<T>::iscan_request(MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _value(_value), _bucket(_bucket)
+{
+    iscan_impl(this->_comm, this->_handle, this->_value, this->_bucket, this->_operation.get());
+}
+template <class T>
+iexscan_request<T>::iexscan_request(MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _value(_value), _bucket(_bucket)
+{
+    iexscan_impl(this->_comm, this->_handle, this->_value, this->_bucket, this->_operation.get());
+}
+template <class T>
+auto iexscan_request<T>::complete() -> void
+{
+    if (impl::rank(this->_comm) == 0)
+        impl::clear_values(this->_bucket);
+}
+template <class T>
+ireduce_scatter_request<T>::ireduce_scatter_request(MPI_Comm _comm, const T &_value, T &_bucket, impl::v_counts &&_counts, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _counts(std::move(_counts)), _value(_value)
+{
+    ireduce_scatter_impl(this->_comm, this->_handle, this->_value, _bucket, this->_counts, this->_operation.get());
+}
+template <class T>
+ireduce_scatter_block_request<T>::ireduce_scatter_block_request(MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _value(_value)
+{
+    ireduce_scatter_block_impl(this->_comm, this->_handle, this->_value, _bucket, this->_operation.get());
+}
+template <class T>
+send_init_request<T>::send_init_request(int _dest, int _tag, MPI_Comm _comm, const T &_value) : persistent_request(_comm), _dest(_dest), _tag(_tag), _value(_value)
+{
+    send_init_impl(this->_dest, this->_tag, this->_comm, this->_handle, this->_value);
+}
+template <class T>
+ssend_init_request<T>::ssend_init_request(int _dest, int _tag, MPI_Comm _comm, const T &_value) : persistent_request(_comm), _dest(_dest), _tag(_tag), _value(_value)
+{
+    ssend_init_impl(this->_dest, this->_tag, this->_comm, this->_handle, this->_value);
+}
+template <class T>
+rsend_init_request<T>::rsend_init_request(int _dest, int _tag, MPI_Comm _comm, const T &_value) : persistent_request(_comm), _dest(_dest), _tag(_tag), _value(_value)
+{
+    rsend_init_impl(this->_dest, this->_tag, this->_comm, this->_handle, this->_value);
+}
+template <class T>
+recv_init_request<T>::recv_init_request(int _source, int _tag, MPI_Comm _comm, T &_value) : persistent_request(_comm), _source(_source), _tag(_tag), _bucket(_value)
+{
+    recv_init_impl(this->_source, this->_tag, this->_comm, this->_handle, this->_bucket);
+}
+template <class T>
+auto recv_init_request<T>::emulate_start() -> bool
+{
+    //startall starts the request right away if no earlier receive is in the way
+    this->is_posted = impl::receive_queue::is_next(this, this->_comm, this->_source, this->_tag, false);
+    if (!this->is_posted)
+        impl::receive_queue::push(this, this->_comm, this->_source, this->_tag);
+    return !this->is_posted;
+}
+template <class T>
+auto recv_init_request<T>::post(const bool _blocking) -> bool
+{
+    if (!this->is_posted && impl::receive_queue::is_next(this, this->_comm, this->_source, this->_tag, _blocking))
+    {
+        MPI_Start(this->_handle);
+        this->is_posted = true;
+        impl::receive_queue::pop(this);
+    }
+    return this->is_posted;
+}
+template <class T>
+auto recv_init_request<T>::cancel() -> void
+{
+    //a queued receive was not started, so there is nothing to cancel in MPI
+    if (!this->is_finished && !this->is_canceled && !this->is_posted)
+    {
+        impl::receive_queue::pop(this);
+        this->is_canceled = true;
+        return;
+    }
+    persistent_request::cancel();
+}
+template <class T>
+bcast_init_request<T>::bcast_init_request(int _source, MPI_Comm _comm, T &_value) : persistent_collective_request(_comm), _source(_source), _value(_value)
+{
+    if (impl::has_persistent_collectives)
+        this->init();
+}
+template <class T>
+auto bcast_init_request<T>::init() -> void
+{
+    bcast_init_impl(this->_source, this->_comm, this->_handle, this->_value);
+}
+template <class T>
+allgather_init_request<T>::allgather_init_request(MPI_Comm _comm, const T &_value, std::vector<T> &_bucket) : persistent_collective_request(_comm), _value(_value), _bucket(_bucket)
+{
+    if (impl::has_persistent_collectives)
+        this->init();
+}
+template <class T>
+auto allgather_init_request<T>::init() -> void
+{
+    allgather_init_impl(this->_comm, this->_handle, this->_value, this->_bucket);
+}
+template <class T>
+allgather_init_request<std::vector<T>>::allgather_init_request(MPI_Comm _comm, const std::vector<T> &_value, std::vector<T> &_bucket) : persistent_collective_request(_comm), _value(_value), _bucket(_bucket)
+{
+    if (impl::has_persistent_collectives)
+        this->init();
+}
+template <class T>
+auto allgather_init_request<std::vector<T>>::init() -> void
+{
+    allgather_init_impl(this->_comm, this->_handle, this->_value, this->_bucket);
+}
+template <class T>
+alltoall_init_request<T>::alltoall_init_request(MPI_Comm _comm, const T &_value, T &_bucket, const size_t _chunk_size) : persistent_collective_request(_comm), _chunk_size(_chunk_size), _value(_value), _bucket(_bucket)
+{
+    if (impl::has_persistent_collectives)
+        this->init();
+}
+template <class T>
+auto alltoall_init_request<T>::init() -> void
+{
+    alltoall_init_impl(this->_comm, this->_handle, this->_value, this->_bucket, this->_chunk_size);
+}
+template <class T>
+allreduce_init_request<T>::allreduce_init_request(MPI_Comm _comm, const T &_value, T &_bucket, std::shared_ptr<op> _operation) : persistent_collective_request(_comm), _operation(_operation), _value(_value), _bucket(_bucket)
+{
+    if (impl::has_persistent_collectives)
+        this->init();
+}
+template <class T>
+auto allreduce_init_request<T>::init() -> void
+{
+    allreduce_init_impl(this->_comm, this->_handle, this->_value, this->_bucket, this->_operation.get());
+}
+#pragma endregion
+#pragma region start
+template <class... T>
+auto startall(std::unique_ptr<T> &... _values) -> void
+{
+    startall(std::vector<persistent_request *>{_values.get()...});
+}
+template <class... T>
+auto startall(T *... _values) -> void
+{
+    startall(std::vector<persistent_request *>{_values...});
+}
 #pragma endregion
 #pragma region test
 template <class... T>
@@ -1234,6 +4171,13 @@ auto waitsome(T *... _values) -> std::vector<size_t>
     return waitsome(std::vector<request *>{_values...});
 }
 #pragma endregion
+#pragma region request set
+template <class T>
+auto request_set::add(std::unique_ptr<T> &_value) -> size_t
+{
+    return add(_value.get());
+}
+#pragma endregion
 #pragma region sender_receiver
 template <class T, class U>
 auto sender_receiver::sendrecv(const U &_value, T &_bucket) -> void
@@ -1260,6 +4204,11 @@ auto sender_receiver::sendrecv(const std::string &_value, T &_bucket) -> void
 {
     return sendrecv_impl(_dest, _source, _sendtag, _recvtag, _comm, &_status, _value, _bucket);
 }
+template <class T, class U>
+auto sender_receiver::sendrecv(view<U> _value, view<T> _bucket) -> void
+{
+    return sendrecv_impl(_dest, _source, _sendtag, _recvtag, _comm, &_status, _value, _bucket);
+}
 
 template <class T, class U>
 auto sender_receiver::sendrecv(const U &_value) -> T
@@ -1313,6 +4262,11 @@ auto receiver::recv(T &_value) -> void
     recv_impl(_source, _tag, _comm, &_status, _value);
 }
 template <class T>
+auto receiver::recv(view<T> _value) -> void
+{
+    recv_impl(_source, _tag, _comm, &_status, _value);
+}
+template <class T>
 auto receiver::irecv() -> std::unique_ptr<irecv_reply<T>>
 {
     return std::make_unique<irecv_reply<T>>(_source, _tag, _comm);
@@ -1322,9 +4276,34 @@ auto receiver::irecv(T &_value) -> std::unique_ptr<irecv_request<T>>
 {
     return std::make_unique<irecv_request<T>>(_source, _tag, _comm, _value);
 }
+template <class T>
+auto receiver::irecv(view<T> _value) -> std::unique_ptr<irecv_request<view<T>>>
+{
+    return std::make_unique<irecv_request<view<T>>>(_source, _tag, _comm, _value);
+}
+template <class T>
+auto receiver::recv_init(T &_value) -> std::unique_ptr<recv_init_request<T>>
+{
+    return std::make_unique<recv_init_request<T>>(_source, _tag, _comm, _value);
+}
+template <class T>
+auto receiver::bcast_init(T &_value) -> std::unique_ptr<bcast_init_request<T>>
+{
+    return std::make_unique<bcast_init_request<T>>(_source, _comm, _value);
+}
 
 template <class T>
 auto receiver::bcast(T &_value) -> void
+{
+    bcast_impl(_source, _comm, _value, impl::get_hierarchy(_comm));
+}
+template <class T>
+auto receiver::bcast(T &_value, hierarchy _mode) -> void
+{
+    bcast_impl(_source, _comm, _value, _mode);
+}
+template <class T>
+auto receiver::bcast(view<T> _value) -> void
 {
     bcast_impl(_source, _comm, _value);
 }
@@ -1360,6 +4339,26 @@ auto receiver::bcast(const std::string &_value) -> std::enable_if_t<std::is_same
     return _bucket;
 }
 template <class T>
+auto receiver::share(const std::vector<T> &_value) -> shared_array<T>
+{
+    //every node needs the size before the memory can be allocated
+    auto _size = static_cast<std::uint64_t>(_value.size());
+    MPI_Bcast(&_size, 1, MPI_UINT64_T, _source, _comm);
+    auto _array = shared_array<T>{_comm, static_cast<size_t>(_size)};
+    //the root writes straight into the memory of its node, the node leaders pass it on to the other nodes
+    if (impl::rank(_comm) == _source)
+        std::copy(_value.begin(), _value.end(), _array.data());
+    _array.sync();
+    auto &_layout = impl::node_info(_comm);
+    if (_layout._leaders != MPI_COMM_NULL)
+    {
+        auto _count = impl::large_count{_size, type_wrapper<T>{}};
+        MPIWRAP_LARGE(MPI_Bcast)(_array.data(), _count.count(), _count.type(), _layout._leader_of[_source], _layout._leaders);
+    }
+    _array.sync();
+    return _array;
+}
+template <class T>
 auto receiver::ibcast(T &_value) -> std::unique_ptr<ibcast_request<T>>
 {
     return std::make_unique<ibcast_request<T>>(_source, _comm, _value);
@@ -1412,6 +4411,34 @@ auto receiver::iscatter(const std::vector<T> &_value, const size_t _chunk_size)
 {
     return std::make_unique<iscatter_reply<std::vector<T>>>(_source, _comm, _value, _chunk_size);
 }
+
+template <class T>
+auto receiver::scatterv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> void
+{
+    return scatterv(_value, _bucket, _counts, impl::scatter_count(_source, _comm, _counts));
+}
+template <class T>
+auto receiver::scatterv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, const size_t _chunk_size) -> void
+{
+    return scatterv_impl(_source, _comm, _value, _bucket, impl::make_counts(_counts), _chunk_size);
+}
+template <class T>
+auto receiver::scatterv(const std::vector<T> &_value, const std::vector<size_t> &_counts) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    scatterv(_value, _bucket, _counts);
+    return _bucket;
+}
+template <class T>
+auto receiver::iscatterv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> std::unique_ptr<iscatterv_request<std::vector<T>>>
+{
+    return iscatterv(_value, _bucket, _counts, impl::scatter_count(_source, _comm, _counts));
+}
+template <class T>
+auto receiver::iscatterv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts, const size_t _chunk_size) -> std::unique_ptr<iscatterv_request<std::vector<T>>>
+{
+    return std::make_unique<iscatterv_request<std::vector<T>>>(_source, _comm, _value, _bucket, impl::make_counts(_counts), _chunk_size);
+}
 #pragma endregion
 #pragma region sender
 template <class T>
@@ -1425,6 +4452,11 @@ auto sender::send(const std::vector<T> &_value) -> void
     return send_impl(_dest, _tag, _comm, _value);
 }
 template <class T>
+auto sender::send(view<T> _value) -> void
+{
+    return send_impl(_dest, _tag, _comm, _value);
+}
+template <class T>
 auto sender::ssend(const T &_value) -> void
 {
     return ssend_impl(_dest, _tag, _comm, _value);
@@ -1456,6 +4488,21 @@ auto sender::isend(const std::vector<T> &_value) -> std::unique_ptr<isend_reques
     return std::make_unique<isend_request<std::vector<T>>>(_dest, _tag, _comm, _value);
 }
 template <class T>
+auto sender::isend(std::vector<T> &&_value) -> std::unique_ptr<isend_request<std::vector<T>>>
+{
+    return std::make_unique<isend_request<std::vector<T>>>(_dest, _tag, _comm, std::move(_value));
+}
+template <class T>
+auto sender::isend(borrowed<T> _value) -> std::unique_ptr<isend_request<borrowed<T>>>
+{
+    return std::make_unique<isend_request<borrowed<T>>>(_dest, _tag, _comm, _value);
+}
+template <class T>
+auto sender::isend(view<T> _value) -> std::unique_ptr<isend_request<view<T>>>
+{
+    return std::make_unique<isend_request<view<T>>>(_dest, _tag, _comm, _value);
+}
+template <class T>
 auto sender::issend(const T &_value) -> std::unique_ptr<issend_request<T>>
 {
     return std::make_unique<issend_request<T>>(_dest, _tag, _comm, _value);
@@ -1466,6 +4513,16 @@ auto sender::issend(const std::vector<T> &_value) -> std::unique_ptr<issend_requ
     return std::make_unique<issend_request<std::vector<T>>>(_dest, _tag, _comm, _value);
 }
 template <class T>
+auto sender::issend(std::vector<T> &&_value) -> std::unique_ptr<issend_request<std::vector<T>>>
+{
+    return std::make_unique<issend_request<std::vector<T>>>(_dest, _tag, _comm, std::move(_value));
+}
+template <class T>
+auto sender::issend(borrowed<T> _value) -> std::unique_ptr<issend_request<borrowed<T>>>
+{
+    return std::make_unique<issend_request<borrowed<T>>>(_dest, _tag, _comm, _value);
+}
+template <class T>
 auto sender::irsend(const T &_value) -> std::unique_ptr<irsend_request<T>>
 {
     return std::make_unique<irsend_request<T>>(_dest, _tag, _comm, _value);
@@ -1475,6 +4532,31 @@ auto sender::irsend(const std::vector<T> &_value) -> std::unique_ptr<irsend_requ
 {
     return std::make_unique<irsend_request<std::vector<T>>>(_dest, _tag, _comm, _value);
 }
+template <class T>
+auto sender::irsend(std::vector<T> &&_value) -> std::unique_ptr<irsend_request<std::vector<T>>>
+{
+    return std::make_unique<irsend_request<std::vector<T>>>(_dest, _tag, _comm, std::move(_value));
+}
+template <class T>
+auto sender::irsend(borrowed<T> _value) -> std::unique_ptr<irsend_request<borrowed<T>>>
+{
+    return std::make_unique<irsend_request<borrowed<T>>>(_dest, _tag, _comm, _value);
+}
+template <class T>
+auto sender::send_init(const T &_value) -> std::unique_ptr<send_init_request<T>>
+{
+    return std::make_unique<send_init_request<T>>(_dest, _tag, _comm, _value);
+}
+template <class T>
+auto sender::ssend_init(const T &_value) -> std::unique_ptr<ssend_init_request<T>>
+{
+    return std::make_unique<ssend_init_request<T>>(_dest, _tag, _comm, _value);
+}
+template <class T>
+auto sender::rsend_init(const T &_value) -> std::unique_ptr<rsend_init_request<T>>
+{
+    return std::make_unique<rsend_init_request<T>>(_dest, _tag, _comm, _value);
+}
 
 template <class T>
 auto sender::gather(const T &_value, std::vector<T> &_bucket) -> void
@@ -1487,6 +4569,11 @@ auto sender::gather(const std::vector<T> &_value, std::vector<T> &_bucket) -> vo
     return gather_impl(_dest, _comm, _value, _bucket);
 }
 template <class T>
+auto sender::gather(view<T> _value, std::vector<T> &_bucket) -> void
+{
+    return gather_impl(_dest, _comm, _value, _bucket);
+}
+template <class T>
 auto sender::gather(const T &_value) -> std::vector<T>
 {
     return gather(std::vector<T>{_value});
@@ -1519,15 +4606,53 @@ auto sender::igather(const std::vector<T> &_value) -> std::unique_ptr<igather_re
     return std::make_unique<igather_reply<std::vector<T>>>(_dest, _comm, _value);
 }
 
+template <class T>
+auto sender::gatherv(const std::vector<T> &_value, std::vector<T> &_bucket) -> void
+{
+    return gatherv_impl(_dest, _comm, _value, _bucket, impl::gather_counts(_dest, _comm, _value.size()));
+}
+template <class T>
+auto sender::gatherv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> void
+{
+    return gatherv_impl(_dest, _comm, _value, _bucket, impl::make_counts(_counts));
+}
+template <class T>
+auto sender::gatherv(const std::vector<T> &_value) -> std::vector<T>
+{
+    auto _bucket = std::vector<T>{};
+    gatherv(_value, _bucket);
+    return _bucket;
+}
+template <class T>
+auto sender::igatherv(const std::vector<T> &_value, std::vector<T> &_bucket) -> std::unique_ptr<igatherv_request<std::vector<T>>>
+{
+    return std::make_unique<igatherv_request<std::vector<T>>>(_dest, _comm, _value, _bucket, impl::gather_counts(_dest, _comm, _value.size()));
+}
+template <class T>
+auto sender::igatherv(const std::vector<T> &_value, std::vector<T> &_bucket, const std::vector<size_t> &_counts) -> std::unique_ptr<igatherv_request<std::vector<T>>>
+{
+    return std::make_unique<igatherv_request<std::vector<T>>>(_dest, _comm, _value, _bucket, impl::make_counts(_counts));
+}
+
 template <class T>
 auto sender::reduce(const T &_value, T &_bucket, op *_operation) -> void
 {
-    return reduce_impl(_dest, _comm, _value, _bucket, _operation);
+    return reduce_impl(_dest, _comm, _value, _bucket, _operation, impl::get_hierarchy(_comm));
 }
 template <class T>
 auto sender::reduce(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation) -> void
 {
-    return reduce_impl(_dest, _comm, _value, _bucket, _operation);
+    return reduce_impl(_dest, _comm, _value, _bucket, _operation, impl::get_hierarchy(_comm));
+}
+template <class T>
+auto sender::reduce(const T &_value, T &_bucket, op *_operation, hierarchy _mode) -> void
+{
+    return reduce_impl(_dest, _comm, _value, _bucket, _operation, _mode);
+}
+template <class T>
+auto sender::reduce(const std::vector<T> &_value, std::vector<T> &_bucket, op *_operation, hierarchy _mode) -> void
+{
+    return reduce_impl(_dest, _comm, _value, _bucket, _operation, _mode);
 }
 template <class T>
 auto sender::reduce(const T &_value, op *_operation) -> T
@@ -1547,12 +4672,22 @@ auto sender::reduce(const std::vector<T> &_value, op *_operation) -> std::vector
 template <class T, class Op>
 auto sender::reduce(const T &_value, T &_bucket, Op _operation) -> void
 {
-    return reduce_impl(_dest, _comm, _value, _bucket, make_op<T>(_operation).get());
+    return reduce(_value, _bucket, make_op<T>(_operation).get());
 }
 template <class T, class Op>
 auto sender::reduce(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation) -> void
 {
-    return reduce_impl(_dest, _comm, _value, _bucket, make_op<T>(_operation).get());
+    return reduce(_value, _bucket, make_op<T>(_operation).get());
+}
+template <class T, class Op>
+auto sender::reduce(const T &_value, T &_bucket, Op _operation, hierarchy _mode) -> void
+{
+    return reduce(_value, _bucket, make_op<T>(_operation).get(), _mode);
+}
+template <class T, class Op>
+auto sender::reduce(const std::vector<T> &_value, std::vector<T> &_bucket, Op _operation, hierarchy _mode) -> void
+{
+    return reduce(_value, _bucket, make_op<T>(_operation).get(), _mode);
 }
 template <class Op>
 auto sender::reduce(const char _value, std::string &_bucket, Op _operation) -> void
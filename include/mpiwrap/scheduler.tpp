@@ -170,7 +170,9 @@ auto scheduler<Tasks...>::execute(Task _task) -> decltype(_task.get_result())
                 //send not finished signal
                 _communicator->dest(worker.id())->isend(false)->wait();
                 //direct_subtask task
-                worker.activate(_task.subtask_id(), std::move(_task.direct_subtask(_communicator->source(worker.id()).get(), _communicator->dest(worker.id()).get(), _task.subtask_id())));
+                auto _source = _communicator->source(worker.id());
+                auto _dest = _communicator->dest(worker.id());
+                worker.activate(_task.subtask_id(), std::move(_task.direct_subtask(&_source, &_dest, _task.subtask_id())));
                 _task.advance_to_next_subtask();
                 if (_task.is_finished())
                     break;
@@ -247,7 +249,9 @@ auto scheduler<Tasks...>::run() -> void
                     //YES!
                     else
                     {
-                        _task->execute_subtask(_communicator->source(0).get(), _communicator->dest(0).get());
+                        auto _source = _communicator->source(0);
+                        auto _dest = _communicator->dest(0);
+                        _task->execute_subtask(&_source, &_dest);
                     }
                 }
                 //cleanup
@@ -1,5 +1,10 @@
 #include <mpiwrap/mpi.h>
 #include <algorithm>
+#include <array>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
 
 namespace mpi
 {
@@ -27,6 +32,389 @@ auto processor_name() -> std::string
     return std::string{name.data()};
 }
 #pragma endregion
+#pragma region borrowed buffer
+auto borrow(const std::string &_value) -> borrowed<char>
+{
+    return borrowed<char>{_value.data(), _value.size()};
+}
+#pragma endregion
+#pragma region size policy
+namespace impl
+{
+auto current_size_policy() -> size_policy &
+{
+#ifdef BE_PARANOID
+    static auto _policy = size_policy::checked;
+#else
+    static auto _policy = size_policy::trusted;
+#endif
+    return _policy;
+}
+auto negotiate_size() -> bool
+{
+    //only the policy decides, it is the same on every rank, so either all or none of them enter the broadcast
+    return current_size_policy() == size_policy::checked;
+}
+auto check_size(MPI_Comm _comm, int _root, size_t _size) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //broadcast the size of the root
+    auto _root_size = static_cast<std::uint64_t>(_size);
+    MPI_Bcast(&_root_size, 1, MPI_UINT64_T, _root, _comm);
+    //check size, this has to hold in release builds as well, the other ranks cannot recover from a mismatch
+    if (_size != _root_size)
+    {
+        std::cerr << "mpiwrap: size " << _size << " does not match size " << _root_size << " of the root\n";
+        MPI_Abort(_comm, MPI_ERR_COUNT);
+    }
+}
+} // namespace impl
+auto set_size_policy(size_policy _policy) -> void
+{
+    impl::current_size_policy() = _policy;
+}
+auto get_size_policy() -> size_policy
+{
+    return impl::current_size_policy();
+}
+#pragma endregion
+#pragma region large counts
+namespace impl
+{
+large_count::large_count(size_t _count, MPI_Datatype _type) : _count(static_cast<count_type>(_count)), _type(_type)
+{
+#if MPI_VERSION < 4
+    if (_count <= max_count)
+        return;
+    //full blocks of max_count elements, followed by the remainder
+    auto _lower_bound = MPI_Aint{};
+    auto _extent = MPI_Aint{};
+    MPI_Type_get_extent(_type, &_lower_bound, &_extent);
+    auto _block = MPI_Datatype{};
+    MPI_Type_contiguous(static_cast<int>(max_count), _type, &_block);
+    auto _blocks = MPI_Datatype{};
+    MPI_Type_contiguous(static_cast<int>(_count / max_count), _block, &_blocks);
+    auto _remainder = MPI_Datatype{};
+    MPI_Type_contiguous(static_cast<int>(_count % max_count), _type, &_remainder);
+    int _lengths[] = {1, 1};
+    MPI_Aint _displacements[] = {0, static_cast<MPI_Aint>(_count - _count % max_count) * _extent};
+    MPI_Datatype _types[] = {_blocks, _remainder};
+    auto _struct = MPI_Datatype{};
+    MPI_Type_create_struct(2, _lengths, _displacements, _types, &_struct);
+    //the extent has to cover the whole buffer, so collectives find the part of every rank
+    MPI_Type_create_resized(_struct, 0, static_cast<MPI_Aint>(_count) * _extent, &this->_type);
+    MPI_Type_commit(&this->_type);
+    MPI_Type_free(&_struct);
+    MPI_Type_free(&_remainder);
+    MPI_Type_free(&_blocks);
+    MPI_Type_free(&_block);
+    this->_count = 1;
+    this->is_derived = true;
+#endif
+}
+large_count::large_count(large_count &&_other) : _count(_other._count), _type(_other._type), is_derived(_other.is_derived)
+{
+    _other.is_derived = false;
+}
+large_count::~large_count()
+{
+    //pending operations keep the type alive until they are finished
+    if (this->is_derived && !finalized())
+        MPI_Type_free(&this->_type);
+}
+auto checked_count(size_t _count) -> count_type
+{
+    if (_count > max_count)
+        throw std::length_error{"mpiwrap: " + std::to_string(_count) + " elements do not fit into a single call"};
+    return static_cast<count_type>(_count);
+}
+auto large_count::count() const -> count_type
+{
+    return this->_count;
+}
+auto large_count::type() const -> MPI_Datatype
+{
+    return this->_type;
+}
+auto get_count(const MPI_Status *_status, MPI_Datatype _type) -> size_t
+{
+#if MPI_VERSION >= 4
+    auto _count = MPI_Count{};
+    MPI_Get_count_c(_status, _type, &_count);
+    return static_cast<size_t>(_count);
+#else
+    auto _count = int{};
+    MPI_Get_count(_status, _type, &_count);
+    if (_count != MPI_UNDEFINED)
+        return static_cast<size_t>(_count);
+    //too many elements for an int, so they are counted in bytes
+    auto _bytes = MPI_Count{};
+    MPI_Get_elements_x(_status, MPI_BYTE, &_bytes);
+    auto _size = MPI_Count{};
+    MPI_Type_size_x(_type, &_size);
+    return static_cast<size_t>(_bytes / _size);
+#endif
+}
+} // namespace impl
+#pragma endregion
+#pragma region variable counts
+namespace impl
+{
+auto make_counts(const std::vector<size_t> &_counts) -> v_counts
+{
+    auto _result = v_counts{};
+    _result._counts.reserve(_counts.size());
+    _result._displacements.reserve(_counts.size());
+    for (auto _count : _counts)
+    {
+        //the displacements take the same integer type, so the whole buffer has to fit
+        if (_result._total + _count > max_count)
+            throw std::length_error{"mpiwrap: " + std::to_string(_result._total + _count) + " elements do not fit into a variable count collective"};
+        _result._counts.push_back(static_cast<count_type>(_count));
+        _result._displacements.push_back(static_cast<displacement_type>(_result._total));
+        _result._total += _count;
+    }
+    return _result;
+}
+auto allgather_counts(MPI_Comm _comm, size_t _count) -> v_counts
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _own = static_cast<std::uint64_t>(_count);
+    auto _all = std::vector<std::uint64_t>(size(_comm));
+    MPI_Allgather(&_own, 1, MPI_UINT64_T, _all.data(), 1, MPI_UINT64_T, _comm);
+    return make_counts(std::vector<size_t>(_all.begin(), _all.end()));
+}
+auto alltoall_counts(MPI_Comm _comm, const std::vector<size_t> &_counts) -> v_counts
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //one count for every process
+    assert((_counts.size() == static_cast<size_t>(size(_comm))));
+    auto _sent = std::vector<std::uint64_t>(_counts.begin(), _counts.end());
+    auto _received = std::vector<std::uint64_t>(_counts.size());
+    MPI_Alltoall(_sent.data(), 1, MPI_UINT64_T, _received.data(), 1, MPI_UINT64_T, _comm);
+    return make_counts(std::vector<size_t>(_received.begin(), _received.end()));
+}
+auto gather_counts(int _dest, MPI_Comm _comm, size_t _count) -> v_counts
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _own = static_cast<std::uint64_t>(_count);
+    auto _all = std::vector<std::uint64_t>(rank(_comm) == _dest ? size(_comm) : 0);
+    MPI_Gather(&_own, 1, MPI_UINT64_T, _all.data(), 1, MPI_UINT64_T, _dest, _comm);
+    return make_counts(std::vector<size_t>(_all.begin(), _all.end()));
+}
+auto scatter_count(int _source, MPI_Comm _comm, const std::vector<size_t> &_counts) -> size_t
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _all = std::vector<std::uint64_t>{};
+    if (rank(_comm) == _source)
+    {
+        //one count for every process
+        assert((_counts.size() == static_cast<size_t>(size(_comm))));
+        _all.assign(_counts.begin(), _counts.end());
+    }
+    auto _own = std::uint64_t{};
+    MPI_Scatter(_all.data(), 1, MPI_UINT64_T, &_own, 1, MPI_UINT64_T, _source, _comm);
+    return static_cast<size_t>(_own);
+}
+} // namespace impl
+#pragma endregion
+#pragma region hierarchy
+namespace impl
+{
+auto hierarchy_keyval() -> int
+{
+    static auto _keyval = [] {
+        auto _keyval = int{};
+        //the sub-communicators die with the communicator, duplicates start without a layout
+        auto _delete = [](MPI_Comm, int, void *_attribute, void *) -> int {
+            auto _info = static_cast<hierarchy_info *>(_attribute);
+            if (_info->_node != MPI_COMM_NULL)
+                MPI_Comm_free(&_info->_node);
+            if (_info->_leaders != MPI_COMM_NULL)
+                MPI_Comm_free(&_info->_leaders);
+            delete _info;
+            return MPI_SUCCESS;
+        };
+        MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, _delete, &_keyval, nullptr);
+        return _keyval;
+    }();
+    return _keyval;
+}
+auto find_hierarchy(MPI_Comm _comm, const bool _create) -> hierarchy_info *
+{
+    auto _info = static_cast<hierarchy_info *>(nullptr);
+    auto _found = int{};
+    MPI_Comm_get_attr(_comm, hierarchy_keyval(), &_info, &_found);
+    if (_found)
+        return _info;
+    if (!_create)
+        return nullptr;
+    _info = new hierarchy_info{};
+    MPI_Comm_set_attr(_comm, hierarchy_keyval(), _info);
+    return _info;
+}
+auto build_hierarchy(MPI_Comm _comm, hierarchy_info &_info) -> void
+{
+    auto _rank = rank(_comm);
+    auto _size = size(_comm);
+    //one communicator per shared memory node and one for the first process of every node
+    MPI_Comm_split_type(_comm, MPI_COMM_TYPE_SHARED, _rank, MPI_INFO_NULL, &_info._node);
+    auto _node_rank = rank(_info._node);
+    MPI_Comm_split(_comm, (_node_rank == 0) ? 0 : MPI_UNDEFINED, _rank, &_info._leaders);
+    //every process learns the node layout of all others
+    auto _local = std::array<int, 2>{(_info._leaders != MPI_COMM_NULL) ? rank(_info._leaders) : 0, _node_rank};
+    MPI_Bcast(_local.data(), 1, MPI_INT, 0, _info._node);
+    auto _layout = std::vector<int>(2 * _size);
+    MPI_Allgather(_local.data(), 2, MPI_INT, _layout.data(), 2, MPI_INT, _comm);
+    _info._leader_of.resize(_size);
+    _info._node_rank.resize(_size);
+    for (auto i = 0; i < _size; ++i)
+    {
+        _info._leader_of[i] = _layout[2 * i];
+        _info._node_rank[i] = _layout[2 * i + 1];
+    }
+    _info._node_sizes.assign(*std::max_element(_info._leader_of.begin(), _info._leader_of.end()) + 1, 0);
+    for (auto _leader : _info._leader_of)
+        ++_info._node_sizes[_leader];
+    _info._order.resize(_size);
+    std::iota(_info._order.begin(), _info._order.end(), 0);
+    std::stable_sort(_info._order.begin(), _info._order.end(), [&](int lhs, int rhs) { return _info._leader_of[lhs] < _info._leader_of[rhs]; });
+    _info.is_ordered = std::is_sorted(_info._leader_of.begin(), _info._leader_of.end());
+    _info.is_flat = _info._node_sizes.size() == 1 || _info._node_sizes.size() == static_cast<size_t>(_size);
+    _info.is_built = true;
+}
+//set once any communicator was switched to node-aware, until then every default is flat
+auto is_node_aware_used() -> bool &
+{
+    static auto _used = false;
+    return _used;
+}
+auto get_hierarchy(MPI_Comm _comm) -> hierarchy
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //flat collectives skip the attribute lookup
+    if (!is_node_aware_used())
+        return hierarchy::flat;
+    auto _info = find_hierarchy(_comm, false);
+    return (_info != nullptr) ? _info->_mode : hierarchy::flat;
+}
+auto set_hierarchy(MPI_Comm _comm, hierarchy _mode) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    if (_mode == hierarchy::flat && !is_node_aware_used())
+        return;
+    is_node_aware_used() = true;
+    find_hierarchy(_comm, true)->_mode = _mode;
+}
+auto node_info(MPI_Comm _comm) -> const hierarchy_info &
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _info = find_hierarchy(_comm, true);
+    if (!_info->is_built)
+        build_hierarchy(_comm, *_info);
+    return *_info;
+}
+auto node_layout(MPI_Comm _comm, hierarchy _mode) -> const hierarchy_info *
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    if (_mode == hierarchy::flat)
+        return nullptr;
+    auto &_info = node_info(_comm);
+    return _info.is_flat ? nullptr : &_info;
+}
+} // namespace impl
+#pragma endregion
+#pragma region serialization
+namespace impl
+{
+//only a few buffers are kept, so a burst of large messages does not pin its memory forever
+constexpr auto arena_capacity = size_t{8};
+auto arena() -> std::vector<std::vector<char>> &
+{
+    static auto _buffers = std::vector<std::vector<char>>{};
+    return _buffers;
+}
+auto arena_acquire() -> std::vector<char>
+{
+    auto &_buffers = arena();
+    if (_buffers.empty())
+        return std::vector<char>{};
+    auto _buffer = std::move(_buffers.back());
+    _buffers.pop_back();
+    return _buffer;
+}
+auto arena_release(std::vector<char> &&_buffer) -> void
+{
+    auto &_buffers = arena();
+    if (_buffer.capacity() == 0 || _buffers.size() >= arena_capacity)
+        return;
+    _buffer.clear();
+    _buffers.push_back(std::move(_buffer));
+}
+packed::~packed()
+{
+    arena_release(std::move(this->_buffer));
+}
+auto packed::data() -> char *
+{
+    return this->_buffer.data();
+}
+auto packed::data() const -> const char *
+{
+    return this->_buffer.data();
+}
+auto packed::size() const -> size_t
+{
+    return this->_buffer.size();
+}
+auto packed::resize(size_t _size) -> void
+{
+    if (this->_buffer.capacity() == 0)
+        this->_buffer = arena_acquire();
+    this->_buffer.resize(_size);
+}
+auto serialize(std::vector<char> &_buffer, const std::string &_value) -> void
+{
+    serialize(_buffer, static_cast<std::uint64_t>(_value.size()));
+    _buffer.insert(_buffer.end(), _value.begin(), _value.end());
+}
+auto deserialize(const char *&_position, std::string &_value) -> void
+{
+    auto _size = std::uint64_t{};
+    deserialize(_position, _size);
+    _value.assign(_position, _size);
+    _position += _size;
+}
+auto send_packed(int _dest, int _tag, MPI_Comm _comm, const packed &_value) -> void
+{
+    auto _count = large_count{_value.size(), MPI_BYTE};
+    MPIWRAP_LARGE(MPI_Send)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm);
+}
+auto recv_packed(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status) -> packed
+{
+    //the probe needs a real status, even if the caller ignores it
+    auto _local = MPI_Status{};
+    if (_status == MPI_STATUS_IGNORE)
+        _status = &_local;
+    MPI_Probe(_source, _tag, _comm, _status);
+    auto _value = packed{};
+    _value.resize(get_count(_status, MPI_BYTE));
+    //receive exactly the probed message, a wildcard could match another one
+    auto _count = large_count{_value.size(), MPI_BYTE};
+    MPIWRAP_LARGE(MPI_Recv)(_value.data(), _count.count(), _count.type(), _status->MPI_SOURCE, _status->MPI_TAG, _comm, _status);
+    return _value;
+}
+} // namespace impl
+#pragma endregion
 #pragma region init
 mpi::mpi(int argc, char **argv)
 {
@@ -39,6 +427,8 @@ mpi::~mpi()
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
+    //user-defined operations have to be freed before MPI is gone
+    impl::free_ops();
     //add error checking
     MPI_Finalize();
 }
@@ -70,21 +460,18 @@ auto allgather_impl(MPI_Comm _comm, const std::string &_value, std::string &_buc
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
     //get world size
-    auto _size = comm(_comm)->size();
-    //broadcast the chunk_size before the data is gathered
-    auto _chunk_size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_chunk_size);
-    //check size
-    assert((_value.size() == _chunk_size));
-    //we need to allocate some memory for the result
-    auto _c_str = std::make_unique<char[]>(_size * _chunk_size + 1);
+    auto _size = impl::size(_comm);
+    //check the chunk_size against the root before the data is gathered
+    auto _chunk_size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _chunk_size);
+    //resize bucket to take all characters
+    if (_size * _chunk_size != _bucket.size())
+        _bucket.resize(_size * _chunk_size);
     //gather the data
-    MPI_Allgather(_value.c_str(), _chunk_size, MPI_CHAR, _c_str.get(), _chunk_size, MPI_CHAR, _comm);
-    //we need to write the value back
-    _bucket = std::string{_c_str.get()};
+    auto _count = impl::large_count{_chunk_size, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Allgather)(_value.data(), _count.count(), _count.type(), &_bucket[0], _count.count(), _count.type(), _comm);
 }
 #pragma endregion
 #pragma region allreduce
@@ -92,19 +479,19 @@ auto allreduce_impl(MPI_Comm _comm, const std::string &_value, std::string &_buc
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the chunk_size before the string is reduced
-    auto _size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
-    //we need to allocate some memory for the result
-    auto _c_str = std::make_unique<char[]>((_rank == 0) ? _size + 1 : 0);
-    //reduce the data
-    MPI_Allreduce(_value.c_str(), _c_str.get(), _size, MPI_CHAR, _operation->get(), _comm);
-    //we need to write the value back
-    _bucket = std::string{_c_str.get()};
+    //check the chunk_size against the root before the string is reduced
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
+    //resize bucket to take all characters
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
+    //reduce the data, derived types do not work with builtin operations, so large strings are reduced in chunks
+    for (auto _offset = size_t{}; _offset < _size; _offset += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_size - _offset, impl::max_count));
+        MPIWRAP_LARGE(MPI_Allreduce)(_value.data() + _offset, &_bucket[_offset], _count, _operation->type(MPI_CHAR), _operation->get(), _comm);
+    }
 }
 #pragma endregion
 #pragma region alltoall
@@ -112,21 +499,18 @@ auto alltoall_impl(MPI_Comm _comm, const std::string &_value, std::string &_buck
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the size before the data is gathered
-    auto _size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
+    //check the size against the root before the data is gathered
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
     //double check size
-    assert((_size >= _chunk_size * comm(_comm)->size()));
-    //we need to allocate some memory for the result
-    auto _c_str = std::make_unique<char[]>(_size + 1);
+    assert((_size >= _chunk_size * impl::size(_comm)));
+    //resize bucket to take all characters
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
     //gather the data
-    MPI_Alltoall(_value.c_str(), _chunk_size, MPI_CHAR, _c_str.get(), _chunk_size, MPI_CHAR, _comm);
-    //we need to write the value back
-    _bucket = std::string{_c_str.get()};
+    auto _count = impl::large_count{_chunk_size, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Alltoall)(_value.data(), _count.count(), _count.type(), &_bucket[0], _count.count(), _count.type(), _comm);
 }
 #pragma endregion
 #pragma region broadcast
@@ -135,19 +519,16 @@ auto bcast_impl(int _source, MPI_Comm _comm, std::string &_value) -> void
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     //get current rank
-    auto _rank = comm(_comm)->rank();
+    auto _rank = impl::rank(_comm);
     //broadcast the size before the string
-    auto _size = (_rank == _source) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(_source)->bcast(_size);
-    //we need to allocate some memory for it
-    auto _c_str = std::make_unique<char[]>(_size + 1);
-    //we need to copy the data into the right place
-    if (_rank == _source)
-        std::strcpy(_c_str.get(), _value.c_str());
+    auto _size = (_rank == _source) ? static_cast<std::uint64_t>(_value.size()) : std::uint64_t{};
+    MPI_Bcast(&_size, 1, MPI_UINT64_T, _source, _comm);
+    //resize the string if not the sender
+    if (_rank != _source)
+        _value.resize(_size);
     //broadcast the data
-    MPI_Bcast(_c_str.get(), _size, MPI_CHAR, _source, _comm);
-    //at we need to write the value back
-    _value = std::string{_c_str.get()};
+    auto _count = impl::large_count{_size, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Bcast)(&_value[0], _count.count(), _count.type(), _source, _comm);
 }
 #pragma endregion
 #pragma region gather
@@ -156,21 +537,22 @@ auto gather_impl(int _dest, MPI_Comm _comm, const std::string &_value, std::stri
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     //get current rank
-    auto _rank = comm(_comm)->rank();
+    auto _rank = impl::rank(_comm);
     //get world size
-    auto _size = comm(_comm)->size();
-    //broadcast the chunk_size before the string is gathered
-    auto _chunk_size = (_rank == _dest) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(_dest)->bcast(_chunk_size);
-    //check size
-    assert((_value.size() == _chunk_size));
-    //we need to allocate some memory for the result
-    auto _c_str = std::make_unique<char[]>((_rank == _dest) ? _size * _chunk_size + 1 : 0);
-    //gather the data
-    MPI_Gather(_value.c_str(), _chunk_size, MPI_CHAR, _c_str.get(), _chunk_size, MPI_CHAR, _dest, _comm);
-    //we need to write the value back
+    auto _size = impl::size(_comm);
+    //check the chunk_size against the root before the string is gathered
+    auto _chunk_size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, _dest, _chunk_size);
+    //resize bucket to take all characters
     if (_rank == _dest)
-        _bucket = std::string{_c_str.get()};
+    {
+        if (_size * _chunk_size != _bucket.size())
+            _bucket.resize(_size * _chunk_size);
+    }
+    //gather the data
+    auto _count = impl::large_count{_chunk_size, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Gather)(_value.data(), _count.count(), _count.type(), &_bucket[0], _count.count(), _count.type(), _dest, _comm);
 }
 #pragma endregion
 #pragma region receive
@@ -178,16 +560,16 @@ auto recv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, std::
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //we need to find the proper size of the incoming string
-    MPI_Probe(_source, _tag, _comm, _status);
-    auto _size = int{};
-    MPI_Get_count(_status, MPI_CHAR, &_size);
-    //we need to allocate some memory for it
-    auto _c_str = std::make_unique<char[]>(_size + 1);
-    //we need to receive it
-    MPI_Recv(_c_str.get(), _size, MPI_CHAR, _source, _tag, _comm, _status);
-    //we need to write the value back
-    _value = std::string{_c_str.get()};
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _tag, true);
+    //the matched probe tells us the proper size of the incoming string
+    auto _message = MPI_Message{};
+    auto _probe_status = MPI_Status{};
+    MPI_Mprobe(_source, _tag, _comm, &_message, &_probe_status);
+    _value.resize(impl::get_count(&_probe_status, MPI_CHAR));
+    //we need to receive exactly the probed message
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Mrecv)(&_value[0], _count.count(), _count.type(), &_message, _status);
 }
 #pragma endregion
 #pragma region reduce
@@ -196,19 +578,23 @@ auto reduce_impl(int _dest, MPI_Comm _comm, const std::string &_value, std::stri
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the chunk_size before the string is reduced
-    auto _size = (_rank == _dest) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(_dest)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
-    //we need to allocate some memory for the result
-    auto _c_str = std::make_unique<char[]>((_rank == _dest) ? _size + 1 : 0);
-    //reduce the data
-    MPI_Reduce(_value.c_str(), _c_str.get(), _size, MPI_CHAR, _operation->get(), _dest, _comm);
-    //we need to write the value back
+    auto _rank = impl::rank(_comm);
+    //check the chunk_size against the root before the string is reduced
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, _dest, _size);
+    //resize bucket to take all characters
     if (_rank == _dest)
-        _bucket = std::string{_c_str.get()};
+    {
+        if (_size != _bucket.size())
+            _bucket.resize(_size);
+    }
+    //reduce the data, derived types do not work with builtin operations, so large strings are reduced in chunks
+    for (auto _offset = size_t{}; _offset < _size; _offset += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_size - _offset, impl::max_count));
+        MPIWRAP_LARGE(MPI_Reduce)(_value.data() + _offset, (_rank == _dest) ? &_bucket[_offset] : nullptr, _count, _operation->type(MPI_CHAR), _operation->get(), _dest, _comm);
+    }
 }
 #pragma endregion
 #pragma region local reduce
@@ -216,12 +602,15 @@ auto reduce(const std::string &_value, std::string &_bucket, op *_operation) ->
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //we need to allocate some memory for the result
-    auto _c_str = std::make_unique<char[]>(_value.size() + 1);
-    //reduce the data
-    MPI_Reduce_local(_value.c_str(), _c_str.get(), _value.size(), MPI_CHAR, _operation->get());
-    //we need to write the value back
-    _bucket = std::string{_c_str.get()};
+    //resize bucket to take all characters
+    if (_value.size() != _bucket.size())
+        _bucket.resize(_value.size());
+    //reduce the data in chunks, like allreduce
+    for (auto _offset = size_t{}; _offset < _value.size(); _offset += impl::max_count)
+    {
+        auto _count = static_cast<impl::count_type>(std::min(_value.size() - _offset, impl::max_count));
+        MPIWRAP_LARGE(MPI_Reduce_local)(_value.data() + _offset, &_bucket[_offset], _count, _operation->type(MPI_CHAR), _operation->get());
+    }
 }
 
 auto reduce(const std::string &_value, op *_operation) -> std::string
@@ -236,18 +625,12 @@ auto scatter_impl(int _source, MPI_Comm _comm, const std::string &_value, std::s
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //we need a copy of the original data
-    auto _c_str = std::make_unique<char[]>(0);
-    if (_rank == _source)
-        std::strcpy(_c_str.get(), _value.c_str());
-    //create result container
-    auto _chunk = std::make_unique<char[]>(_chunk_size + 1);
+    //resize bucket to take all characters
+    if (_chunk_size != _bucket.size())
+        _bucket.resize(_chunk_size);
     //scatter the data
-    MPI_Scatter(_c_str.get(), _chunk_size, MPI_CHAR, _chunk.get(), _chunk_size, MPI_CHAR, _source, _comm);
-    //at we need to write the value back
-    _bucket = std::string{_chunk.get()};
+    auto _count = impl::large_count{_chunk_size, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Scatter)(_value.data(), _count.count(), _count.type(), &_bucket[0], _count.count(), _count.type(), _source, _comm);
 }
 #pragma endregion
 #pragma region send
@@ -255,7 +638,8 @@ auto send_impl(int _dest, int _tag, MPI_Comm _comm, const std::string &_value) -
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Send(_value.c_str(), _value.size(), MPI_CHAR, _dest, _tag, _comm);
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Send)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm);
 }
 #pragma endregion
 #pragma region synchronized send
@@ -263,7 +647,15 @@ auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const std::string &_value)
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Ssend(_value.c_str(), _value.size(), MPI_CHAR, _dest, _tag, _comm);
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Ssend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm);
+}
+auto ssend_impl(int _dest, int _tag, MPI_Comm _comm, const impl::packed &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), MPI_BYTE};
+    MPIWRAP_LARGE(MPI_Ssend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm);
 }
 #pragma endregion
 #pragma region ready mode send
@@ -271,7 +663,8 @@ auto rsend_impl(int _dest, int _tag, MPI_Comm _comm, const std::string &_value)
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Rsend(_value.c_str(), _value.size(), MPI_CHAR, _dest, _tag, _comm);
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Rsend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm);
 }
 #pragma endregion
 #pragma region send and receive
@@ -279,163 +672,192 @@ auto sendrecv_impl(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
+    //earlier nonblocking receives have to be matched first
+    impl::receive_queue::is_next(nullptr, _comm, _source, _recvtag, true);
     //we need to find the proper size of the incoming data
-    auto _sendsize = static_cast<int>(_value.size());
-    auto _recvsize = int{};
-    MPI_Sendrecv(&_sendsize, 1, type_wrapper<int>{}, _dest, _sendtag, &_recvsize, 1, type_wrapper<int>{}, _source, _recvtag, _comm, _status);
-    //we need to allocate some memory for it
-    auto _c_str = std::make_unique<char[]>(_recvsize + 1);
+    auto _sendsize = static_cast<std::uint64_t>(_value.size());
+    auto _recvsize = std::uint64_t{};
+    MPI_Sendrecv(&_sendsize, 1, MPI_UINT64_T, _dest, _sendtag, &_recvsize, 1, MPI_UINT64_T, _source, _recvtag, _comm, _status);
+    //the value has to be sent from a separate buffer if it is the bucket as well
+    auto _copy = (&_value == &_bucket) ? _value : std::string{};
+    const auto &_sent = (&_value == &_bucket) ? _copy : _value;
+    //resize bucket to take all characters
+    _bucket.resize(_recvsize);
     //send and receive
-    MPI_Sendrecv(_value.c_str(), _sendsize + 1, MPI_CHAR, _dest, _sendtag, _c_str.get(), _recvsize + 1, MPI_CHAR, _source, _recvtag, _comm, _status);
-    //we need to write the value back
-    _bucket = std::string{_c_str.get()};
+    auto _sendcount = impl::large_count{_sendsize, MPI_CHAR};
+    auto _recvcount = impl::large_count{_recvsize, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Sendrecv)(_sent.data(), _sendcount.count(), _sendcount.type(), _dest, _sendtag, &_bucket[0], _recvcount.count(), _recvcount.type(), _source, _recvtag, _comm, _status);
 }
 #pragma endregion
 
 #pragma region nonblocking allgather
-auto iallgather_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket) -> void
+auto iallgather_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
     //get world size
-    auto _size = comm(_comm)->size();
-    //broadcast the chunk_size before the data is gathered
-    auto _chunk_size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_chunk_size);
-    //check size
-    assert((_value.size() == _chunk_size));
-    //we need to allocate some memory for the result
-    _bucket = std::make_unique<char[]>(_size * _chunk_size + 1);
+    auto _size = impl::size(_comm);
+    //check the chunk_size against the root before the data is gathered
+    auto _chunk_size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _chunk_size);
+    //resize bucket to take all characters
+    if (_size * _chunk_size != _bucket.size())
+        _bucket.resize(_size * _chunk_size);
     //gather the data
-    MPI_Iallgather(_value.c_str(), _chunk_size, MPI_CHAR, _bucket.get(), _chunk_size, MPI_CHAR, _comm, _request);
+    auto _count = impl::large_count{_chunk_size, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Iallgather)(_value.data(), _count.count(), _count.type(), &_bucket[0], _count.count(), _count.type(), _comm, _request);
 }
 #pragma endregion
 #pragma region nonblocking allreduce
-auto iallreduce_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket, op *_operation) -> void
+auto iallreduce_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket, op *_operation) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the chunk_size before the string is reduced
-    auto _size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
-    //we need to allocate some memory for the result
-    _bucket = std::make_unique<char[]>((_rank == 0) ? _size + 1 : 0);
+    //check the chunk_size against the root before the string is reduced
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
+    //one request cannot be split into chunks, so before MPI-4 the size is limited
+    auto _count = impl::checked_count(_size);
+    //resize bucket to take all characters
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
     //reduce the data
-    MPI_Iallreduce(_value.c_str(), _bucket.get(), _size, MPI_CHAR, _operation->get(), _comm, _request);
+    MPIWRAP_LARGE(MPI_Iallreduce)(_value.data(), &_bucket[0], _count, _operation->type(MPI_CHAR), _operation->get(), _comm, _request);
 }
 #pragma endregion
 #pragma region nonblocking alltoall
-auto ialltoall_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket, const size_t _chunk_size) -> void
+auto ialltoall_impl(MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket, const size_t _chunk_size) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the size before the data is gathered
-    auto _size = (_rank == 0) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(0)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
+    //check the size against the root before the data is gathered
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, 0, _size);
     //double check size
-    assert((_size >= _chunk_size * comm(_comm)->size()));
-    //we need to allocate some memory for the result
-    _bucket = std::make_unique<char[]>(_size + 1);
+    assert((_size >= _chunk_size * impl::size(_comm)));
+    //resize bucket to take all characters
+    if (_size != _bucket.size())
+        _bucket.resize(_size);
     //gather the data
-    MPI_Ialltoall(_value.c_str(), _chunk_size, MPI_CHAR, _bucket.get(), _chunk_size, MPI_CHAR, _comm, _request);
+    auto _count = impl::large_count{_chunk_size, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Ialltoall)(_value.data(), _count.count(), _count.type(), &_bucket[0], _count.count(), _count.type(), _comm, _request);
 }
 #pragma endregion
 #pragma region nonblocking broadcast
-auto ibcast_impl(int _source, MPI_Comm _comm, MPI_Request *_request, std::unique_ptr<char[]> &_value) -> void
+auto ibcast_impl(int _source, MPI_Comm _comm, MPI_Request *_request, std::string &_value) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     //get current rank
-    auto _rank = comm(_comm)->rank();
+    auto _rank = impl::rank(_comm);
     //broadcast the size before the string
-    auto _size = (_rank == _source) ? static_cast<int>(std::strlen(_value.get()) + 1) : int{};
-    comm(_comm)->source(_source)->bcast(_size);
-    //we need to allocate some memory for it
+    auto _size = (_rank == _source) ? static_cast<std::uint64_t>(_value.size()) : std::uint64_t{};
+    MPI_Bcast(&_size, 1, MPI_UINT64_T, _source, _comm);
+    //resize the string if not the sender
     if (_rank != _source)
-        _value = std::make_unique<char[]>(_size + 1);
+        _value.resize(_size);
     //broadcast the data
-    MPI_Ibcast(_value.get(), _size, MPI_CHAR, _source, _comm, _request);
+    auto _count = impl::large_count{_size, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Ibcast)(&_value[0], _count.count(), _count.type(), _source, _comm, _request);
 }
 #pragma endregion
 #pragma region nonblocking gather
-auto igather_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket) -> void
+auto igather_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     //get current rank
-    auto _rank = comm(_comm)->rank();
+    auto _rank = impl::rank(_comm);
     //get world size
-    auto _size = comm(_comm)->size();
-    //broadcast the chunk_size before the string is gathered
-    auto _chunk_size = (_rank == _dest) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(_dest)->bcast(_chunk_size);
-    //check size
-    assert((_value.size() == _chunk_size));
-    //we need to allocate some memory for the result
-    _bucket = std::make_unique<char[]>((_rank == _dest) ? _size * _chunk_size + 1 : 1);
+    auto _size = impl::size(_comm);
+    //check the chunk_size against the root before the string is gathered
+    auto _chunk_size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, _dest, _chunk_size);
+    //resize bucket to take all characters
+    if (_rank == _dest)
+    {
+        if (_size * _chunk_size != _bucket.size())
+            _bucket.resize(_size * _chunk_size);
+    }
     //gather the data
-    MPI_Igather(_value.c_str(), _chunk_size, MPI_CHAR, _bucket.get(), _chunk_size, MPI_CHAR, _dest, _comm, _request);
+    auto _count = impl::large_count{_chunk_size, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Igather)(_value.data(), _count.count(), _count.type(), &_bucket[0], _count.count(), _count.type(), _dest, _comm, _request);
 }
 #pragma endregion
 #pragma region nonblocking receive
-auto irecv_impl(int _source, int _tag, MPI_Comm _comm, MPI_Status *_status, MPI_Request *_request, std::unique_ptr<char[]> &_value) -> void
+auto improbe_impl(int _source, int _tag, MPI_Comm _comm, MPI_Message *_message, MPI_Status *_status, const bool _blocking) -> bool
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //we need to find the proper size of the incoming string
-    MPI_Probe(_source, _tag, _comm, _status);
-    auto _size = int{};
-    MPI_Get_count(_status, MPI_CHAR, &_size);
-    //we need to allocate some memory for it
-    _value = std::make_unique<char[]>(_size + 1);
-    //we need to receive it
-    MPI_Irecv(_value.get(), _size, MPI_CHAR, _source, _tag, _comm, _request);
+    //only block if we are asked to
+    if (_blocking)
+    {
+        MPI_Mprobe(_source, _tag, _comm, _message, _status);
+        return true;
+    }
+    //otherwise just check if the message has arrived
+    auto _flag = int{};
+    MPI_Improbe(_source, _tag, _comm, &_flag, _message, _status);
+    return _flag == true;
+}
+auto irecv_impl(MPI_Message *_message, MPI_Status *_status, MPI_Request *_request, std::string &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //the matched probe tells us the proper size of the incoming string
+    _value.resize(impl::get_count(_status, MPI_CHAR));
+    //we need to receive exactly the probed message
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Imrecv)(&_value[0], _count.count(), _count.type(), _message, _request);
+}
+auto irecv_impl(MPI_Message *_message, MPI_Status *_status, MPI_Request *_request, impl::packed &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //the matched probe tells us the proper size of the packed bytes
+    _value.resize(impl::get_count(_status, MPI_BYTE));
+    auto _count = impl::large_count{_value.size(), MPI_BYTE};
+    MPIWRAP_LARGE(MPI_Imrecv)(_value.data(), _count.count(), _count.type(), _message, _request);
 }
 #pragma endregion
 #pragma region nonblocking reduce
-auto ireduce_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket, op *_operation) -> void
+auto ireduce_impl(int _dest, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket, op *_operation) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     //get current rank
-    auto _rank = comm(_comm)->rank();
-    //broadcast the chunk_size before the string is reduced
-    auto _size = (_rank == _dest) ? static_cast<int>(_value.size()) : int{};
-    comm(_comm)->source(_dest)->bcast(_size);
-    //check size
-    assert((_value.size() == _size));
-    //we need to allocate some memory for the result
-    _bucket = std::make_unique<char[]>((_rank == _dest) ? _size + 1 : 0);
+    auto _rank = impl::rank(_comm);
+    //check the chunk_size against the root before the string is reduced
+    auto _size = _value.size();
+    if (impl::negotiate_size())
+        impl::check_size(_comm, _dest, _size);
+    //one request cannot be split into chunks, so before MPI-4 the size is limited
+    auto _count = impl::checked_count(_size);
+    //resize bucket to take all characters
+    if (_rank == _dest)
+    {
+        if (_size != _bucket.size())
+            _bucket.resize(_size);
+    }
     //reduce the data
-    MPI_Ireduce(_value.c_str(), _bucket.get(), _size, MPI_CHAR, _operation->get(), _dest, _comm, _request);
+    MPIWRAP_LARGE(MPI_Ireduce)(_value.data(), (_rank == _dest) ? &_bucket[0] : nullptr, _count, _operation->type(MPI_CHAR), _operation->get(), _dest, _comm, _request);
 }
 #pragma endregion
 #pragma region nonblocking scatter
-auto iscatter_impl(int _source, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::unique_ptr<char[]> &_bucket, const size_t _chunk_size) -> void
+auto iscatter_impl(int _source, MPI_Comm _comm, MPI_Request *_request, const std::string &_value, std::string &_bucket, const size_t _chunk_size) -> void
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    //get current rank
-    auto _rank = comm(_comm)->rank();
-    //we need a copy of the original data
-
-    auto _c_str = std::make_unique<char[]>(0);
-    if (_rank == _source)
-        std::strcpy(_c_str.get(), _value.c_str());
-    //create result container
-    _bucket = std::make_unique<char[]>(_chunk_size + 1);
+    //resize bucket to take all characters
+    if (_chunk_size != _bucket.size())
+        _bucket.resize(_chunk_size);
     //scatter the data
-    MPI_Iscatter(_c_str.get(), _chunk_size, MPI_CHAR, _bucket.get(), _chunk_size, MPI_CHAR, _source, _comm, _request);
+    auto _count = impl::large_count{_chunk_size, MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Iscatter)(_value.data(), _count.count(), _count.type(), &_bucket[0], _count.count(), _count.type(), _source, _comm, _request);
 }
 #pragma endregion
 #pragma region nonblocking send
@@ -443,7 +865,15 @@ auto isend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, cons
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Isend(_value.c_str(), _value.size(), MPI_CHAR, _dest, _tag, _comm, _request);
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Isend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+auto isend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const impl::packed &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), MPI_BYTE};
+    MPIWRAP_LARGE(MPI_Isend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
 }
 #pragma endregion
 #pragma region nonblocking synchronized send
@@ -451,7 +881,15 @@ auto issend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, con
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Issend(_value.c_str(), _value.size(), MPI_CHAR, _dest, _tag, _comm, _request);
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Issend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+auto issend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const impl::packed &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), MPI_BYTE};
+    MPIWRAP_LARGE(MPI_Issend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
 }
 #pragma endregion
 #pragma region nonblocking ready mode send
@@ -459,52 +897,236 @@ auto irsend_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, con
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    MPI_Irsend(_value.c_str(), _value.size(), MPI_CHAR, _dest, _tag, _comm, _request);
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Irsend)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+#pragma endregion
+#pragma region persistent send
+auto send_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Send_init)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+#pragma endregion
+#pragma region persistent synchronized send
+auto ssend_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Ssend_init)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+#pragma endregion
+#pragma region persistent ready mode send
+auto rsend_init_impl(int _dest, int _tag, MPI_Comm _comm, MPI_Request *_request, const std::string &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Rsend_init)(_value.data(), _count.count(), _count.type(), _dest, _tag, _comm, _request);
+}
+#pragma endregion
+#pragma region persistent receive
+auto recv_init_impl(int _source, int _tag, MPI_Comm _comm, MPI_Request *_request, std::string &_value) -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //the message must not be larger than the bucket, it is not resized
+    auto _count = impl::large_count{_value.size(), MPI_CHAR};
+    MPIWRAP_LARGE(MPI_Recv_init)(&_value[0], _count.count(), _count.type(), _source, _tag, _comm, _request);
 }
 #pragma endregion
 
 #pragma region communicator
-communicator::communicator(MPI_Comm _comm) : _comm(_comm)
+namespace impl
 {
+auto rank(MPI_Comm _comm) -> int
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _rank = int{};
+    MPI_Comm_rank(_comm, &_rank);
+    return _rank;
 }
-auto communicator::size() -> int
+auto size(MPI_Comm _comm) -> int
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
     auto _size = int{};
-    //add error checking
     MPI_Comm_size(_comm, &_size);
     return _size;
 }
-auto communicator::rank() -> int
+} // namespace impl
+communicator::communicator(MPI_Comm _comm, const bool _duplicate) : _comm(_comm), is_owner(_duplicate)
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    auto _rank = int{};
-    //add error checking
-    MPI_Comm_rank(_comm, &_rank);
+    if (_duplicate && this->_comm != MPI_COMM_NULL)
+        MPI_Comm_dup(_comm, &this->_comm);
+}
+communicator::communicator(communicator &&_other) : _comm(_other._comm), _rank(_other._rank), _size(_other._size), is_owner(_other.is_owner)
+{
+    _other._comm = MPI_COMM_NULL;
+    _other.is_owner = false;
+}
+communicator::~communicator()
+{
+    //the communicator cannot be freed anymore after MPI was finalized
+    if (is_owner && _comm != MPI_COMM_NULL && !finalized())
+        MPI_Comm_free(&_comm);
+}
+auto communicator::operator=(communicator &&_other) -> communicator &
+{
+    if (this != &_other)
+    {
+        if (is_owner && _comm != MPI_COMM_NULL && !finalized())
+            MPI_Comm_free(&_comm);
+        _comm = _other._comm;
+        _rank = _other._rank;
+        _size = _other._size;
+        is_owner = _other.is_owner;
+        _other._comm = MPI_COMM_NULL;
+        _other.is_owner = false;
+    }
+    return *this;
+}
+auto communicator::adopt(MPI_Comm _comm) -> std::unique_ptr<communicator>
+{
+    if (_comm == MPI_COMM_NULL)
+        return nullptr;
+    auto _result = std::make_unique<communicator>(_comm);
+    _result->is_owner = true;
+    return _result;
+}
+auto communicator::size() const -> int
+{
+    //rank and size cannot change, so they are only asked for once
+    if (_size == MPI_UNDEFINED && _comm != MPI_COMM_NULL)
+        MPI_Comm_size(_comm, &_size);
+    return _size;
+}
+auto communicator::rank() const -> int
+{
+    if (_rank == MPI_UNDEFINED && _comm != MPI_COMM_NULL)
+        MPI_Comm_rank(_comm, &_rank);
     return _rank;
 }
-auto communicator::name() -> std::string
+auto communicator::name() const -> std::string
+{
+    //the name can be changed with MPI_Comm_set_name, so it is not cached
+    if (_comm == MPI_COMM_NULL)
+        return std::string{};
+    auto _name = std::array<char, MPI_MAX_OBJECT_NAME>{};
+    auto _length = int{};
+    MPI_Comm_get_name(_comm, _name.data(), &_length);
+    return std::string{_name.data(), static_cast<size_t>(_length)};
+}
+auto communicator::get() const -> MPI_Comm
+{
+    return _comm;
+}
+auto communicator::set_hierarchy(hierarchy _mode) -> void
+{
+    impl::set_hierarchy(_comm, _mode);
+}
+auto communicator::get_hierarchy() const -> hierarchy
+{
+    return impl::get_hierarchy(_comm);
+}
+
+auto communicator::dest(int _dest, int _tag) -> sender
+{
+    return sender{_dest, _tag, _comm};
+}
+auto communicator::source(int _source, int _tag) -> receiver
+{
+    return receiver{_source, _tag, _comm};
+}
+
+auto communicator::dup() -> std::unique_ptr<communicator>
 {
     paranoidly_assert((initialized()));
     paranoidly_assert((!finalized()));
-    auto _name = std::make_unique<char[]>(MPI_MAX_OBJECT_NAME);
-    auto _size = MPI_MAX_OBJECT_NAME;
-    //add error checking
-    MPI_Comm_get_name(_comm, _name.get(), &_size);
-    return std::string{_name.get()};
+    auto _newcomm = MPI_Comm{};
+    MPI_Comm_dup(_comm, &_newcomm);
+    return adopt(_newcomm);
 }
-
-auto communicator::dest(int _dest) -> std::unique_ptr<sender>
+auto communicator::idup() -> std::unique_ptr<idup_reply>
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    return std::make_unique<idup_reply>(_comm);
+}
+auto communicator::split(int _color, int _key) -> std::unique_ptr<communicator>
 {
-    auto _tag = 0;
-    return std::make_unique<sender>(_dest, _tag, _comm);
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _newcomm = MPI_Comm{};
+    MPI_Comm_split(_comm, _color, _key, &_newcomm);
+    return adopt(_newcomm);
 }
-auto communicator::source(int _source) -> std::unique_ptr<receiver>
+auto communicator::split_type(int _type, int _key) -> std::unique_ptr<communicator>
 {
-    auto _tag = 0;
-    return std::make_unique<receiver>(_source, _tag, _comm);
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _newcomm = MPI_Comm{};
+    MPI_Comm_split_type(_comm, _type, _key, MPI_INFO_NULL, &_newcomm);
+    return adopt(_newcomm);
+}
+auto communicator::create(const std::vector<int> &_ranks) -> std::unique_ptr<communicator>
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _group = MPI_Group{};
+    auto _subgroup = MPI_Group{};
+    MPI_Comm_group(_comm, &_group);
+    MPI_Group_incl(_group, _ranks.size(), _ranks.data(), &_subgroup);
+    auto _newcomm = MPI_Comm{};
+    MPI_Comm_create(_comm, _subgroup, &_newcomm);
+    MPI_Group_free(&_subgroup);
+    MPI_Group_free(&_group);
+    return adopt(_newcomm);
+}
+auto communicator::create_group(const std::vector<int> &_ranks, int _tag) -> std::unique_ptr<communicator>
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _group = MPI_Group{};
+    auto _subgroup = MPI_Group{};
+    MPI_Comm_group(_comm, &_group);
+    MPI_Group_incl(_group, _ranks.size(), _ranks.data(), &_subgroup);
+    auto _newcomm = MPI_Comm{};
+    MPI_Comm_create_group(_comm, _subgroup, _tag, &_newcomm);
+    MPI_Group_free(&_subgroup);
+    MPI_Group_free(&_group);
+    return adopt(_newcomm);
+}
+auto communicator::cart_create(std::vector<int> _dims, const std::vector<bool> &_periods, const bool _reorder) -> std::unique_ptr<cart_communicator>
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    assert((_dims.size() == _periods.size()));
+    //let MPI choose the dimensions which were left open, a full grid may also be smaller than the communicator
+    if (std::find(_dims.begin(), _dims.end(), 0) != _dims.end())
+        MPI_Dims_create(size(), _dims.size(), _dims.data());
+    auto _is_periodic = std::vector<int>(_periods.begin(), _periods.end());
+    auto _newcomm = MPI_Comm{};
+    MPI_Cart_create(_comm, _dims.size(), _dims.data(), _is_periodic.data(), _reorder, &_newcomm);
+    return cart_communicator::adopt(_newcomm);
+}
+auto communicator::dist_graph_create_adjacent(const std::vector<int> &_sources, const std::vector<int> &_destinations, const bool _reorder) -> std::unique_ptr<graph_communicator>
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _newcomm = MPI_Comm{};
+    MPI_Dist_graph_create_adjacent(_comm, _sources.size(), _sources.data(), MPI_UNWEIGHTED, _destinations.size(), _destinations.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, _reorder, &_newcomm);
+    return graph_communicator::adopt(_newcomm);
+}
+auto communicator::reduction_batch(size_t _threshold) -> std::unique_ptr<::mpi::reduction_batch>
+{
+    return std::make_unique<::mpi::reduction_batch>(_comm, _threshold);
 }
 
 auto communicator::allgather(const char _value, std::string &_bucket) -> void
@@ -638,40 +1260,202 @@ auto communicator::allreduce(const char _value, op *_operation) -> std::string
 {
     return allreduce(std::string{_value}, _operation);
 }
-auto communicator::allreduce(const char *_value, op *_operation) -> std::string
+auto communicator::allreduce(const char *_value, op *_operation) -> std::string
+{
+    return allreduce(std::string{_value}, _operation);
+}
+auto communicator::allreduce(const std::string &_value, op *_operation) -> std::string
+{
+    auto _bucket = std::string{};
+    allreduce(_value, _bucket, _operation);
+    return _bucket;
+}
+
+auto communicator::iallreduce(const char _value, std::string &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+{
+    return iallreduce(std::string{_value}, _bucket, _operation);
+}
+auto communicator::iallreduce(const char *_value, std::string &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+{
+    return iallreduce(std::string{_value}, _bucket, _operation);
+}
+auto communicator::iallreduce(const std::string &_value, std::string &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+{
+    return std::make_unique<iallreduce_request<std::string>>(_comm, _value, _bucket, _operation);
+}
+auto communicator::iallreduce(const char _value, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+{
+    return iallreduce(std::string{_value}, _operation);
+}
+auto communicator::iallreduce(const char *_value, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+{
+    return iallreduce(std::string{_value}, _operation);
+}
+auto communicator::iallreduce(const std::string &_value, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+{
+    return std::make_unique<iallreduce_reply<std::string>>(_comm, _value, _operation);
+}
+#pragma endregion
+#pragma region topologies
+namespace impl
+{
+auto neighbor_count(MPI_Comm _comm) -> std::pair<int, int>
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _topology = int{};
+    MPI_Topo_test(_comm, &_topology);
+    auto _sources = int{};
+    auto _destinations = int{};
+    auto _is_weighted = int{};
+    switch (_topology)
+    {
+    case MPI_CART:
+        //two neighbors per dimension, also beyond a non-periodic border
+        MPI_Cartdim_get(_comm, &_sources);
+        _sources *= 2;
+        _destinations = _sources;
+        break;
+    case MPI_GRAPH:
+        MPI_Graph_neighbors_count(_comm, rank(_comm), &_sources);
+        _destinations = _sources;
+        break;
+    case MPI_DIST_GRAPH:
+        MPI_Dist_graph_neighbors_count(_comm, &_sources, &_destinations, &_is_weighted);
+        break;
+    default:
+        //neighbor collectives need a topology
+        assert((false));
+    }
+    return {_sources, _destinations};
+}
+} // namespace impl
+auto cart_communicator::adopt(MPI_Comm _comm) -> std::unique_ptr<cart_communicator>
+{
+    if (_comm == MPI_COMM_NULL)
+        return nullptr;
+    auto _result = std::make_unique<cart_communicator>(_comm);
+    _result->is_owner = true;
+    return _result;
+}
+auto cart_communicator::dims() const -> std::vector<int>
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _ndims = int{};
+    MPI_Cartdim_get(_comm, &_ndims);
+    auto _dims = std::vector<int>(_ndims);
+    auto _periods = std::vector<int>(_ndims);
+    auto _coords = std::vector<int>(_ndims);
+    MPI_Cart_get(_comm, _ndims, _dims.data(), _periods.data(), _coords.data());
+    return _dims;
+}
+auto cart_communicator::periods() const -> std::vector<bool>
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _ndims = int{};
+    MPI_Cartdim_get(_comm, &_ndims);
+    auto _dims = std::vector<int>(_ndims);
+    auto _periods = std::vector<int>(_ndims);
+    auto _coords = std::vector<int>(_ndims);
+    MPI_Cart_get(_comm, _ndims, _dims.data(), _periods.data(), _coords.data());
+    return std::vector<bool>(_periods.begin(), _periods.end());
+}
+auto cart_communicator::coords() const -> std::vector<int>
+{
+    return coords(communicator::rank());
+}
+auto cart_communicator::coords(int _rank) const -> std::vector<int>
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _ndims = int{};
+    MPI_Cartdim_get(_comm, &_ndims);
+    auto _coords = std::vector<int>(_ndims);
+    MPI_Cart_coords(_comm, _rank, _ndims, _coords.data());
+    return _coords;
+}
+auto cart_communicator::rank(const std::vector<int> &_coords) const -> int
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _rank = int{};
+    MPI_Cart_rank(_comm, _coords.data(), &_rank);
+    return _rank;
+}
+auto cart_communicator::shift(int _direction, int _displacement) const -> std::pair<int, int>
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _source = int{};
+    auto _dest = int{};
+    MPI_Cart_shift(_comm, _direction, _displacement, &_source, &_dest);
+    return {_source, _dest};
+}
+auto graph_communicator::adopt(MPI_Comm _comm) -> std::unique_ptr<graph_communicator>
 {
-    return allreduce(std::string{_value}, _operation);
+    if (_comm == MPI_COMM_NULL)
+        return nullptr;
+    auto _result = std::make_unique<graph_communicator>(_comm);
+    _result->is_owner = true;
+    return _result;
 }
-auto communicator::allreduce(const std::string &_value, op *_operation) -> std::string
+auto graph_communicator::sources() const -> std::vector<int>
 {
-    auto _bucket = std::string{};
-    allreduce(_value, _bucket, _operation);
-    return _bucket;
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _counts = impl::neighbor_count(_comm);
+    auto _sources = std::vector<int>(_counts.first);
+    auto _destinations = std::vector<int>(_counts.second);
+    MPI_Dist_graph_neighbors(_comm, _counts.first, _sources.data(), MPI_UNWEIGHTED, _counts.second, _destinations.data(), MPI_UNWEIGHTED);
+    return _sources;
 }
-
-auto communicator::iallreduce(const char _value, std::string &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+auto graph_communicator::destinations() const -> std::vector<int>
 {
-    return iallreduce(std::string{_value}, _bucket, _operation);
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    auto _counts = impl::neighbor_count(_comm);
+    auto _sources = std::vector<int>(_counts.first);
+    auto _destinations = std::vector<int>(_counts.second);
+    MPI_Dist_graph_neighbors(_comm, _counts.first, _sources.data(), MPI_UNWEIGHTED, _counts.second, _destinations.data(), MPI_UNWEIGHTED);
+    return _destinations;
 }
-auto communicator::iallreduce(const char *_value, std::string &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+#pragma endregion
+#pragma region reduction batch
+namespace impl
+{
+batch_state::batch_state(MPI_Comm _comm, size_t _threshold) : _comm(_comm), _threshold(_threshold)
 {
-    return iallreduce(std::string{_value}, _bucket, _operation);
 }
-auto communicator::iallreduce(const std::string &_value, std::string &_bucket, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_request<std::string>>
+auto batch_state::flush() -> void
 {
-    return std::make_unique<iallreduce_request<std::string>>(_comm, _value, _bucket, _operation);
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //all groups are in flight at the same time, so their latencies overlap
+    auto _requests = std::vector<MPI_Request>{};
+    for (auto &&_group : _groups)
+    {
+        auto _request = MPI_Request{};
+        if (_group->post(_comm, &_request))
+            _requests.push_back(_request);
+    }
+    MPI_Waitall(static_cast<int>(_requests.size()), _requests.data(), MPI_STATUSES_IGNORE);
+    for (auto &&_group : _groups)
+        _group->complete();
+    _pending = 0;
 }
-auto communicator::iallreduce(const char _value, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+} // namespace impl
+reduction_batch::reduction_batch(MPI_Comm _comm, size_t _threshold) : _state(std::make_shared<impl::batch_state>(_comm, _threshold))
 {
-    return iallreduce(std::string{_value}, _operation);
 }
-auto communicator::iallreduce(const char *_value, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+auto reduction_batch::pending() const -> size_t
 {
-    return iallreduce(std::string{_value}, _operation);
+    return _state->_pending;
 }
-auto communicator::iallreduce(const std::string &_value, std::shared_ptr<op> _operation) -> std::unique_ptr<iallreduce_reply<std::string>>
+auto reduction_batch::flush() -> void
 {
-    return std::make_unique<iallreduce_reply<std::string>>(_comm, _value, _operation);
+    _state->flush();
 }
 #pragma endregion
 #pragma region comm
@@ -683,8 +1467,10 @@ auto comm(const std::string &_name) -> std::unique_ptr<communicator>
 {
     if (_name == std::string{"world"})
         return comm(MPI_COMM_WORLD);
+    else if (_name == std::string{"self"})
+        return comm(MPI_COMM_SELF);
     else
-        throw;
+        throw std::invalid_argument{"unknown communicator name: " + _name};
 }
 #pragma endregion
 #pragma region compare
@@ -748,237 +1534,313 @@ auto op::commutes() const -> bool
 {
     return _commute;
 }
-#pragma endregion
-#pragma region request
-request::request(MPI_Comm _comm) : _comm(_comm)
+auto op::type(MPI_Datatype _base) const -> MPI_Datatype
 {
+    return (_type != MPI_DATATYPE_NULL) ? _type : _base;
 }
-request::~request()
+auto op::release() -> void
 {
 }
-auto request::cancel() -> void
+namespace impl
 {
-    if (!is_finished && !is_canceled)
-    {
-        MPI_Cancel(&this->_request);
-        is_canceled = true;
-    }
+auto op_cache() -> std::map<std::pair<const void *, bool>, std::shared_ptr<op>> &
+{
+    static auto _operations = std::map<std::pair<const void *, bool>, std::shared_ptr<op>>{};
+    return _operations;
 }
-auto request::test() -> bool
+auto find_op(const void *_key, const bool _commute) -> std::shared_ptr<op>
 {
-    if (!is_finished && !is_canceled)
-    {
-        auto _flag = int{};
-        MPI_Test(&this->_request, &_flag, &this->_status);
-        is_finished = _flag == true;
-    }
-    return is_finished && !is_canceled;
+    auto &_operations = op_cache();
+    auto _found = _operations.find({_key, _commute});
+    return (_found != _operations.end()) ? _found->second : nullptr;
 }
-auto request::wait() -> void
+auto register_op(const void *_key, const bool _commute, std::shared_ptr<op> _operation) -> void
 {
-    if (!is_finished && !is_canceled)
-    {
-        MPI_Wait(&this->_request, &this->_status);
-        is_finished = true;
-    }
+    op_cache()[{_key, _commute}] = std::move(_operation);
 }
+auto op_keyval_handle() -> int &
+{
+    static auto _keyval = int{MPI_KEYVAL_INVALID};
+    return _keyval;
+}
+auto op_keyval() -> int
+{
+    auto &_keyval = op_keyval_handle();
+    //copies of the datatype do not carry the operation
+    if (_keyval == MPI_KEYVAL_INVALID)
+        MPI_Type_create_keyval(MPI_TYPE_NULL_COPY_FN, MPI_TYPE_NULL_DELETE_FN, &_keyval, nullptr);
+    return _keyval;
+}
+auto free_ops() -> void
+{
+    paranoidly_assert((initialized()));
+    paranoidly_assert((!finalized()));
+    //operations still held by requests or batches keep their object, but lose the handle
+    auto &_operations = op_cache();
+    for (auto &&_operation : _operations)
+        _operation.second->release();
+    _operations.clear();
+    if (op_keyval_handle() != MPI_KEYVAL_INVALID)
+        MPI_Type_free_keyval(&op_keyval_handle());
+}
+} // namespace impl
 #pragma endregion
-#pragma region request implementations
-ibarrier_request::ibarrier_request(MPI_Comm _comm) : request(_comm)
+#pragma region request
+namespace impl
+{
+auto receive_queue::entries() -> std::vector<entry> &
+{
+    static auto _entries = std::vector<entry>{};
+    return _entries;
+}
+auto receive_queue::push(request *_request, MPI_Comm _comm, int _source, int _tag) -> void
 {
-    MPI_Ibarrier(this->_comm, &this->_request);
+    entries().push_back(entry{_request, _comm, _source, _tag});
 }
-irecv_request<std::string>::irecv_request(int _source, int _tag, MPI_Comm _comm, std::string &_value) : request(_comm), _source(_source), _tag(_tag), _bucket(_value)
+auto receive_queue::pop(request *_request) -> void
 {
-    irecv_impl(this->_source, this->_tag, this->_comm, &this->_status, &this->_request, this->_c_str);
+    auto &_entries = entries();
+    auto _entry = std::find_if(_entries.begin(), _entries.end(), [_request](auto &_entry) { return _entry._request == _request; });
+    if (_entry != _entries.end())
+        _entries.erase(_entry);
 }
-auto irecv_request<std::string>::wait() -> void
+auto receive_queue::is_next(request *_request, MPI_Comm _comm, int _source, int _tag, const bool _blocking) -> bool
 {
-    if (!this->is_finished && !this->is_canceled)
+    auto &_entries = entries();
+    for (auto i = size_t{0}; i < _entries.size() && _entries[i]._request != _request;)
     {
-        MPI_Wait(&this->_request, &this->_status);
-        this->is_finished = true;
+        //could the earlier receive match the same message?
+        auto &_entry = _entries[i];
+        auto _same_source = _entry._source == _source || _entry._source == MPI_ANY_SOURCE || _source == MPI_ANY_SOURCE;
+        auto _same_tag = _entry._tag == _tag || _entry._tag == MPI_ANY_TAG || _tag == MPI_ANY_TAG;
+        if (_entry._comm == _comm && _same_source && _same_tag)
+        {
+            if (!_blocking)
+                return false;
+            //posting the earlier receive removes it from the queue
+            _entry._request->post(true);
+        }
+        else
+        {
+            ++i;
+        }
     }
-    this->_bucket = std::string{this->_c_str.get()};
+    return true;
 }
-irecv_reply<std::string>::irecv_reply(int _source, int _tag, MPI_Comm _comm) : request(_comm), _source(_source), _tag(_tag)
+auto receive_queue::post(request_set *_set, const bool _blocking) -> bool
 {
-    irecv_impl(this->_source, this->_tag, this->_comm, &this->_status, &this->_request, this->_c_str);
+    //only requests which are still queued have to be looked at, posting removes them from the queue
+    auto &_entries = entries();
+    auto _is_posted = true;
+    for (auto i = size_t{0}; i < _entries.size();)
+    {
+        auto _request = _entries[i]._request;
+        if (_request->_set != _set)
+            ++i;
+        else if (!_request->post(_blocking))
+        {
+            _is_posted = false;
+            ++i;
+        }
+        else if (_blocking)
+        {
+            //blocking posts may have removed earlier entries as well
+            i = 0;
+        }
+    }
+    return _is_posted;
 }
-auto irecv_reply<std::string>::get() -> std::string
+} // namespace impl
+request::request(MPI_Comm _comm) : _comm(_comm), _request(MPI_REQUEST_NULL), _handle(&_request)
 {
-    this->wait();
-    return std::string{this->_c_str.get()};
 }
-ibcast_request<std::string>::ibcast_request(int _source, MPI_Comm _comm, std::string &_value) : request(_comm), _source(_source), _bucket(_value),
-                                                                                                _c_str([](auto _value) {
-                                                                                                    auto temp = std::make_unique<char[]>(_value.size() + 1);
-                                                                                                    std::strcpy(temp.get(), _value.c_str());
-                                                                                                    return temp;
-                                                                                                }(_value))
+request::~request()
 {
-    ibcast_impl(this->_source, this->_comm, &this->_request, this->_c_str);
+    impl::receive_queue::pop(this);
+    if (_set)
+        _set->detach(_slot);
 }
-auto ibcast_request<std::string>::wait() -> void
+auto request::post(const bool) -> bool
 {
-    if (!this->is_finished && !this->is_canceled)
-    {
-        MPI_Wait(&this->_request, &this->_status);
-        this->is_finished = true;
-    }
-    this->_bucket = std::string{this->_c_str.get()};
+    return true;
 }
-ibcast_reply<std::string>::ibcast_reply(int _source, MPI_Comm _comm, const std::string &_value) : request(_comm), _source(_source),
-                                                                                                  _c_str([](auto _value) {
-                                                                                                      auto temp = std::make_unique<char[]>(_value.size() + 1);
-                                                                                                      std::strcpy(temp.get(), _value.c_str());
-                                                                                                      return temp;
-                                                                                                  }(_value))
+auto request::complete() -> void
 {
-    ibcast_impl(this->_source, this->_comm, &this->_request, this->_c_str);
 }
-auto ibcast_reply<std::string>::get() -> std::string
+auto request::finish() -> void
 {
-    this->wait();
-    return std::string{this->_c_str.get()};
+    is_finished = true;
+    complete();
 }
-
-iscatter_request<std::string>::iscatter_request(int _source, MPI_Comm _comm, const std::string &_value, std::string &_bucket, const size_t _chunk_size) : request(_comm), _source(_source), _chunk_size(_chunk_size), _value(_value), _bucket(_bucket)
+auto request::cancel() -> void
 {
-    iscatter_impl(this->_source, this->_comm, &this->_request, this->_value, this->_c_str, this->_chunk_size);
+    if (!is_finished && !is_canceled)
+    {
+        //requests which are not posted yet have nothing to cancel
+        if (*this->_handle != MPI_REQUEST_NULL)
+            MPI_Cancel(this->_handle);
+        impl::receive_queue::pop(this);
+        is_canceled = true;
+    }
 }
-auto iscatter_request<std::string>::wait() -> void
+auto request::test() -> bool
 {
-    if (!this->is_finished && !this->is_canceled)
+    if (!is_finished && !is_canceled && post(false))
     {
-        MPI_Wait(&this->_request, &this->_status);
-        this->is_finished = true;
+        auto _flag = int{};
+        MPI_Test(this->_handle, &_flag, &this->_status);
+        if (_flag == true)
+            finish();
     }
-    this->_bucket = std::string{this->_c_str.get()};
+    return is_finished && !is_canceled;
 }
-iscatter_reply<std::string>::iscatter_reply(int _source, MPI_Comm _comm, const std::string &_value, const size_t _chunk_size) : request(_comm), _source(_source), _chunk_size(_chunk_size), _value(_value)
+auto request::wait() -> void
 {
-    iscatter_impl(this->_source, this->_comm, &this->_request, this->_value, this->_c_str, this->_chunk_size);
+    if (!is_finished && !is_canceled)
+    {
+        post(true);
+        MPI_Wait(this->_handle, &this->_status);
+        finish();
+    }
 }
-auto iscatter_reply<std::string>::get() -> std::string
+#pragma endregion
+#pragma region request implementations
+ibarrier_request::ibarrier_request(MPI_Comm _comm) : request(_comm)
 {
-    this->wait();
-    return std::string{this->_c_str.get()};
+    MPI_Ibarrier(this->_comm, this->_handle);
 }
-
-igather_request<std::string>::igather_request(int _dest, MPI_Comm _comm, const std::string &_value, std::string &_bucket) : request(_comm), _dest(_dest), _value(_value), _bucket(_bucket)
+idup_reply::idup_reply(MPI_Comm _comm) : request(_comm), _newcomm(MPI_COMM_NULL)
 {
-    igather_impl(this->_dest, this->_comm, &this->_request, this->_value, this->_c_str);
+    MPI_Comm_idup(this->_comm, &this->_newcomm, this->_handle);
 }
-auto igather_request<std::string>::wait() -> void
+idup_reply::~idup_reply()
 {
-    if (!this->is_finished && !this->is_canceled)
+    //the new communicator has to exist before it can be freed
+    if (!finalized())
     {
-        MPI_Wait(&this->_request, &this->_status);
-        this->is_finished = true;
+        this->wait();
+        if (this->_newcomm != MPI_COMM_NULL)
+            MPI_Comm_free(&this->_newcomm);
     }
-    this->_bucket = std::string{this->_c_str.get()};
-}
-igather_reply<std::string>::igather_reply(int _dest, MPI_Comm _comm, const std::string &_value) : request(_comm), _dest(_dest), _value(_value)
-{
-    igather_impl(this->_dest, this->_comm, &this->_request, this->_value, this->_c_str);
 }
-auto igather_reply<std::string>::get() -> std::string
+auto idup_reply::get() -> std::unique_ptr<communicator>
 {
     this->wait();
-    return std::string{this->_c_str.get()};
+    auto _result = communicator::adopt(this->_newcomm);
+    this->_newcomm = MPI_COMM_NULL;
+    return _result;
 }
-
-iallgather_request<std::string>::iallgather_request(MPI_Comm _comm, const std::string &_value, std::string &_bucket) : request(_comm), _value(_value), _bucket(_bucket)
+irecv_request<std::string>::irecv_request(int _source, int _tag, MPI_Comm _comm, std::string &_value) : request(_comm), _source(_source), _tag(_tag), _message(MPI_MESSAGE_NULL), _bucket(_value)
 {
-    iallgather_impl(this->_comm, &this->_request, this->_value, this->_c_str);
+    if (!this->post(false))
+        impl::receive_queue::push(this, this->_comm, this->_source, this->_tag);
 }
-auto iallgather_request<std::string>::wait() -> void
+auto irecv_request<std::string>::post(const bool _blocking) -> bool
 {
-    if (!this->is_finished && !this->is_canceled)
+    if (!this->is_posted && impl::receive_queue::is_next(this, this->_comm, this->_source, this->_tag, _blocking) && improbe_impl(this->_source, this->_tag, this->_comm, &this->_message, &this->_status, _blocking))
     {
-        MPI_Wait(&this->_request, &this->_status);
-        this->is_finished = true;
+        irecv_impl(&this->_message, &this->_status, this->_handle, this->_bucket);
+        this->is_posted = true;
+        impl::receive_queue::pop(this);
     }
-    this->_bucket = std::string{this->_c_str.get()};
+    return this->is_posted;
 }
-iallgather_reply<std::string>::iallgather_reply(MPI_Comm _comm, const std::string &_value) : request(_comm), _value(_value)
+irecv_reply<std::string>::irecv_reply(int _source, int _tag, MPI_Comm _comm) : request(_comm), _source(_source), _tag(_tag), _message(MPI_MESSAGE_NULL), _bucket(std::string{})
 {
-    iallgather_impl(this->_comm, &this->_request, this->_value, this->_c_str);
+    if (!this->post(false))
+        impl::receive_queue::push(this, this->_comm, this->_source, this->_tag);
 }
-auto iallgather_reply<std::string>::get() -> std::string
+auto irecv_reply<std::string>::post(const bool _blocking) -> bool
 {
-    this->wait();
-    return std::string{this->_c_str.get()};
+    if (!this->is_posted && impl::receive_queue::is_next(this, this->_comm, this->_source, this->_tag, _blocking) && improbe_impl(this->_source, this->_tag, this->_comm, &this->_message, &this->_status, _blocking))
+    {
+        irecv_impl(&this->_message, &this->_status, this->_handle, this->_bucket);
+        this->is_posted = true;
+        impl::receive_queue::pop(this);
+    }
+    return this->is_posted;
 }
-
-ialltoall_request<std::string>::ialltoall_request(MPI_Comm _comm, const std::string &_value, std::string &_bucket, const size_t _chunk_size) : request(_comm), _chunk_size(_chunk_size), _value(_value), _bucket(_bucket)
+auto irecv_reply<std::string>::get() -> std::string
 {
-    ialltoall_impl(this->_comm, &this->_request, this->_value, this->_c_str, this->_chunk_size);
+    this->wait();
+    return _bucket;
 }
-auto ialltoall_request<std::string>::wait() -> void
+persistent_request::persistent_request(MPI_Comm _comm) : request(_comm)
 {
-    if (!this->is_finished && !this->is_canceled)
-    {
-        MPI_Wait(&this->_request, &this->_status);
-        this->is_finished = true;
-    }
-    this->_bucket = std::string{this->_c_str.get()};
+    //an inactive request counts as finished
+    this->is_finished = true;
 }
-ialltoall_reply<std::string>::ialltoall_reply(MPI_Comm _comm, const std::string &_value, const size_t _chunk_size) : request(_comm), _chunk_size(_chunk_size), _value(_value)
+persistent_request::~persistent_request()
 {
-    ialltoall_impl(this->_comm, &this->_request, this->_value, this->_c_str, this->_chunk_size);
+    if (*this->_handle != MPI_REQUEST_NULL)
+        MPI_Request_free(this->_handle);
 }
-auto ialltoall_reply<std::string>::get() -> std::string
+auto persistent_request::emulate_start() -> bool
 {
-    this->wait();
-    return std::string{this->_c_str.get()};
+    return false;
 }
-
-ireduce_request<std::string>::ireduce_request(int _dest, MPI_Comm _comm, const std::string &_value, std::string &_bucket, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _dest(_dest), _value(_value), _bucket(_bucket)
+auto persistent_request::restart() -> bool
 {
-    ireduce_impl(this->_dest, this->_comm, &this->_request, this->_value, this->_c_str, this->_operation.get());
+    //starting an active request is erroneous, so the previous round is completed first
+    if (this->is_canceled)
+        MPI_Wait(this->_handle, MPI_STATUS_IGNORE);
+    else
+        this->wait();
+    this->is_finished = false;
+    this->is_canceled = false;
+    return !this->emulate_start();
 }
-auto ireduce_request<std::string>::wait() -> void
+auto persistent_request::start() -> void
 {
-    if (!this->is_finished && !this->is_canceled)
-    {
-        MPI_Wait(&this->_request, &this->_status);
-        this->is_finished = true;
-    }
-    this->_bucket = std::string{this->_c_str.get()};
+    if (restart())
+        MPI_Start(this->_handle);
 }
-ireduce_reply<std::string>::ireduce_reply(int _dest, MPI_Comm _comm, const std::string &_value, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _dest(_dest), _value(_value)
+persistent_collective_request::persistent_collective_request(MPI_Comm _comm) : persistent_request(_comm)
 {
-    ireduce_impl(this->_dest, this->_comm, &this->_request, this->_value, this->_c_str, this->_operation.get());
 }
-auto ireduce_reply<std::string>::get() -> std::string
+persistent_collective_request::~persistent_collective_request()
 {
     this->wait();
-    return std::string{this->_c_str.get()};
 }
-
-iallreduce_request<std::string>::iallreduce_request(MPI_Comm _comm, const std::string &_value, std::string &_bucket, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _value(_value), _bucket(_bucket)
+auto persistent_collective_request::emulate_start() -> bool
 {
-    iallreduce_impl(this->_comm, &this->_request, this->_value, this->_c_str, this->_operation.get());
+    if (impl::has_persistent_collectives)
+        return false;
+    init();
+    return true;
 }
-auto iallreduce_request<std::string>::wait() -> void
-{
-    if (!this->is_finished && !this->is_canceled)
+#pragma endregion
+#pragma region start
+auto startall(const std::vector<persistent_request *> &_values) -> void
+{
+    //the arrays keep their capacity, so restarting the same requests does not allocate
+    static auto _requests = std::vector<MPI_Request>{};
+    static auto _handles = std::vector<MPI_Request *>{};
+    _requests.clear();
+    _handles.clear();
+    for (auto _value : _values)
     {
-        MPI_Wait(&this->_request, &this->_status);
-        this->is_finished = true;
+        if (_value->restart())
+        {
+            _requests.push_back(*_value->_handle);
+            _handles.push_back(_value->_handle);
+        }
     }
-    this->_bucket = std::string{this->_c_str.get()};
-}
-iallreduce_reply<std::string>::iallreduce_reply(MPI_Comm _comm, const std::string &_value, std::shared_ptr<op> _operation) : request(_comm), _operation(_operation), _value(_value)
-{
-    iallreduce_impl(this->_comm, &this->_request, this->_value, this->_c_str, this->_operation.get());
+
+    //start, emulated requests have been started already
+    if (!_requests.empty())
+        MPI_Startall(_requests.size(), _requests.data());
+
+    //write back requests
+    for (auto i = size_t{0}; i < _handles.size(); ++i)
+        *_handles[i] = _requests[i];
 }
-auto iallreduce_reply<std::string>::get() -> std::string
+auto startall(const std::vector<std::unique_ptr<persistent_request>> &_values) -> void
 {
-    this->wait();
-    return std::string{this->_c_str.get()};
+    static auto _temp = std::vector<persistent_request *>{};
+    _temp.resize(_values.size());
+    std::transform(_values.begin(), _values.end(), _temp.begin(), [](auto &val) { return val.get(); });
+    return startall(_temp);
 }
 #pragma endregion
 #pragma region test
@@ -992,10 +1854,18 @@ auto test(std::unique_ptr<request> &_value) -> bool
 }
 auto testall(const std::vector<request *> &_values) -> bool
 {
+    //requests which are still waiting for their message cannot be tested yet
+    auto _is_posted = true;
+    for (auto &&_value : _values)
+        if (!_value->is_finished && !_value->is_canceled)
+            _is_posted = _value->post(false) && _is_posted;
+    if (!_is_posted)
+        return false;
+
     //get requests and statuses in the right form
     auto _requests = std::vector<MPI_Request>(_values.size());
     auto _statuses = std::vector<MPI_Status>(_values.size());
-    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return _value->_request; });
+    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return *_value->_handle; });
 
     //test
     auto _flag = int{};
@@ -1006,8 +1876,12 @@ auto testall(const std::vector<request *> &_values) -> bool
         //write back requests and statuses
         for (auto i = size_t{0}; i < _values.size(); ++i)
         {
-            _values[i]->_request = _requests[i];
-            _values[i]->_status = _statuses[i];
+            *_values[i]->_handle = _requests[i];
+            if (!_values[i]->is_finished && !_values[i]->is_canceled)
+            {
+                _values[i]->_status = _statuses[i];
+                _values[i]->finish();
+            }
         }
         return true;
     }
@@ -1024,9 +1898,14 @@ auto testall(const std::vector<std::unique_ptr<request>> &_values) -> bool
 }
 auto testany(const std::vector<request *> &_values) -> std::vector<size_t>
 {
+    //requests which are still waiting for their message get a chance to be posted
+    for (auto &&_value : _values)
+        if (!_value->is_finished && !_value->is_canceled)
+            _value->post(false);
+
     //get requests in the right form
     auto _requests = std::vector<MPI_Request>(_values.size());
-    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return _value->_request; });
+    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return *_value->_handle; });
 
     //test
     auto _index = int{};
@@ -1034,15 +1913,16 @@ auto testany(const std::vector<request *> &_values) -> std::vector<size_t>
     auto _status = MPI_Status{};
     MPI_Testany(_values.size(), _requests.data(), &_index, &_flag, &_status);
 
-    if (_flag == true)
+    if (_flag == true && _index != MPI_UNDEFINED)
     {
         //write back requests
         for (auto i = size_t{0}; i < _values.size(); ++i)
         {
-            _values[i]->_request = _requests[i];
+            *_values[i]->_handle = _requests[i];
         }
         //write back status
         _values[_index]->_status = _status;
+        _values[_index]->finish();
         //return index of completed request
         return std::vector<size_t>{static_cast<size_t>(_index)};
     }
@@ -1059,27 +1939,33 @@ auto testany(const std::vector<std::unique_ptr<request>> &_values) -> std::vecto
 }
 auto testsome(const std::vector<request *> &_values) -> std::vector<size_t>
 {
+    //requests which are still waiting for their message get a chance to be posted
+    for (auto &&_value : _values)
+        if (!_value->is_finished && !_value->is_canceled)
+            _value->post(false);
+
     //get requests and statuses in the right form
     auto _requests = std::vector<MPI_Request>(_values.size());
     auto _statuses = std::vector<MPI_Status>(_values.size());
-    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return _value->_request; });
+    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return *_value->_handle; });
 
     //test
     auto _count = 0;
     auto _indexes = std::vector<int>(_values.size());
     MPI_Testsome(_values.size(), _requests.data(), &_count, _indexes.data(), _statuses.data());
 
-    if (_count > 0)
+    if (_count != MPI_UNDEFINED && _count > 0)
     {
         //write back requests
         for (auto i = size_t{0}; i < _values.size(); ++i)
         {
-            _values[i]->_request = _requests[i];
+            *_values[i]->_handle = _requests[i];
         }
         //write back statuses
         for (auto i = size_t{0}; i < static_cast<size_t>(_count); ++i)
         {
             _values[_indexes[i]]->_status = _statuses[i];
+            _values[_indexes[i]]->finish();
         }
 
         //return indexes of completed request
@@ -1110,10 +1996,15 @@ auto wait(std::unique_ptr<request> &_value) -> void
 }
 auto waitall(const std::vector<request *> &_values) -> void
 {
+    //requests which are still waiting for their message need to be posted first
+    for (auto &&_value : _values)
+        if (!_value->is_finished && !_value->is_canceled)
+            _value->post(true);
+
     //get requests and statuses in the right form
     auto _requests = std::vector<MPI_Request>(_values.size());
     auto _statuses = std::vector<MPI_Status>(_values.size());
-    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return _value->_request; });
+    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return *_value->_handle; });
 
     //wait
     MPI_Waitall(_values.size(), _requests.data(), _statuses.data());
@@ -1121,8 +2012,12 @@ auto waitall(const std::vector<request *> &_values) -> void
     //write back requests and statuses
     for (auto i = size_t{0}; i < _values.size(); ++i)
     {
-        _values[i]->_request = _requests[i];
-        _values[i]->_status = _statuses[i];
+        *_values[i]->_handle = _requests[i];
+        if (!_values[i]->is_finished && !_values[i]->is_canceled)
+        {
+            _values[i]->_status = _statuses[i];
+            _values[i]->finish();
+        }
     }
 }
 auto waitall(const std::vector<std::unique_ptr<request>> &_values) -> void
@@ -1133,22 +2028,42 @@ auto waitall(const std::vector<std::unique_ptr<request>> &_values) -> void
 }
 auto waitany(const std::vector<request *> &_values) -> std::vector<size_t>
 {
+    //as long as some requests are waiting for their message, we have to poll
+    for (auto _is_posted = false; !_is_posted;)
+    {
+        _is_posted = true;
+        for (auto &&_value : _values)
+            if (!_value->is_finished && !_value->is_canceled)
+                _is_posted = _value->post(false) && _is_posted;
+        if (!_is_posted)
+        {
+            auto _index = testany(_values);
+            if (!_index.empty())
+                return _index;
+        }
+    }
+
     //get requests in the right form
     auto _requests = std::vector<MPI_Request>(_values.size());
-    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return _value->_request; });
+    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return *_value->_handle; });
 
     //wait
     auto _index = int{};
     auto _status = MPI_Status{};
     MPI_Waitany(_values.size(), _requests.data(), &_index, &_status);
 
+    //all requests might have been inactive
+    if (_index == MPI_UNDEFINED)
+        return std::vector<size_t>{};
+
     //write back requests
     for (auto i = size_t{0}; i < _values.size(); ++i)
     {
-        _values[i]->_request = _requests[i];
+        *_values[i]->_handle = _requests[i];
     }
     //write back status
     _values[_index]->_status = _status;
+    _values[_index]->finish();
 
     //return index of completed request
     return std::vector<size_t>{static_cast<size_t>(_index)};
@@ -1161,27 +2076,43 @@ auto waitany(const std::vector<std::unique_ptr<request>> &_values) -> std::vecto
 }
 auto waitsome(const std::vector<request *> &_values) -> std::vector<size_t>
 {
+    //as long as some requests are waiting for their message, we have to poll
+    for (auto _is_posted = false; !_is_posted;)
+    {
+        _is_posted = true;
+        for (auto &&_value : _values)
+            if (!_value->is_finished && !_value->is_canceled)
+                _is_posted = _value->post(false) && _is_posted;
+        if (!_is_posted)
+        {
+            auto _indexes = testsome(_values);
+            if (!_indexes.empty())
+                return _indexes;
+        }
+    }
+
     //get requests and statuses in the right form
     auto _requests = std::vector<MPI_Request>(_values.size());
     auto _statuses = std::vector<MPI_Status>(_values.size());
-    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return _value->_request; });
+    std::transform(_values.begin(), _values.end(), _requests.begin(), [](auto &_value) { return *_value->_handle; });
 
     //wait
     auto _count = 0;
     auto _indexes = std::vector<int>(_values.size());
     MPI_Waitsome(_values.size(), _requests.data(), &_count, _indexes.data(), _statuses.data());
 
-    if (_count > 0)
+    if (_count != MPI_UNDEFINED && _count > 0)
     {
         //write back requests
         for (auto i = size_t{0}; i < _values.size(); ++i)
         {
-            _values[i]->_request = _requests[i];
+            *_values[i]->_handle = _requests[i];
         }
         //write back statuses
         for (auto i = size_t{0}; i < static_cast<size_t>(_count); ++i)
         {
             _values[_indexes[i]]->_status = _statuses[i];
+            _values[_indexes[i]]->finish();
         }
 
         //return indexes of completed request
@@ -1201,7 +2132,234 @@ auto waitsome(const std::vector<std::unique_ptr<request>> &_values) -> std::vect
     return waitsome(_temp);
 }
 #pragma endregion
+#pragma region request set
+request_set::request_set(request_set &&_other) : _values(std::move(_other._values)), _requests(std::move(_other._requests)), _statuses(std::move(_other._statuses)), _indexes(std::move(_other._indexes)), _completed(std::move(_other._completed))
+{
+    _other._values.clear();
+    _other._requests.clear();
+    bind();
+}
+request_set &request_set::operator=(request_set &&_other)
+{
+    if (this != &_other)
+    {
+        release();
+        _values = std::move(_other._values);
+        _requests = std::move(_other._requests);
+        _statuses = std::move(_other._statuses);
+        _indexes = std::move(_other._indexes);
+        _completed = std::move(_other._completed);
+        _other._values.clear();
+        _other._requests.clear();
+        bind();
+    }
+    return *this;
+}
+request_set::~request_set()
+{
+    release();
+}
+auto request_set::bind() -> void
+{
+    for (auto i = size_t{0}; i < _values.size(); ++i)
+    {
+        if (!_values[i])
+            continue;
+        _values[i]->_handle = &_requests[i];
+        _values[i]->_set = this;
+        _values[i]->_slot = i;
+    }
+}
+auto request_set::release() -> void
+{
+    for (auto i = size_t{0}; i < _values.size(); ++i)
+    {
+        if (!_values[i])
+            continue;
+        _values[i]->_request = _requests[i];
+        _values[i]->_handle = &_values[i]->_request;
+        _values[i]->_set = nullptr;
+    }
+}
+auto request_set::detach(size_t _index) -> void
+{
+    //the slot stays, so the indexes of the other requests do not change
+    _values[_index] = nullptr;
+    _requests[_index] = MPI_REQUEST_NULL;
+}
+auto request_set::refresh(const bool _blocking) -> bool
+{
+    return impl::receive_queue::post(this, _blocking);
+}
+auto request_set::finish(size_t _index, const MPI_Status &_status) -> void
+{
+    //the handle was already updated in place
+    if (_values[_index] && !_values[_index]->is_finished && !_values[_index]->is_canceled)
+    {
+        _values[_index]->_status = _status;
+        _values[_index]->finish();
+    }
+}
+auto request_set::add(request *_value) -> size_t
+{
+    assert((_value->_set == nullptr));
+    auto _storage = _requests.data();
+    _values.push_back(_value);
+    _requests.push_back(*_value->_handle);
+    _statuses.emplace_back();
+    _indexes.emplace_back();
+    _completed.reserve(_values.size());
+    //growing the storage moves the handles of all requests
+    if (_requests.data() != _storage)
+        bind();
+    else
+    {
+        _value->_handle = &_requests.back();
+        _value->_set = this;
+        _value->_slot = _values.size() - 1;
+    }
+    return _values.size() - 1;
+}
+auto request_set::reserve(size_t _size) -> void
+{
+    auto _storage = _requests.data();
+    _values.reserve(_size);
+    _requests.reserve(_size);
+    _statuses.reserve(_size);
+    _indexes.reserve(_size);
+    _completed.reserve(_size);
+    if (_requests.data() != _storage)
+        bind();
+}
+auto request_set::clear() -> void
+{
+    release();
+    _values.clear();
+    _requests.clear();
+    _statuses.clear();
+    _indexes.clear();
+    _completed.clear();
+}
+auto request_set::size() const -> size_t
+{
+    return _values.size();
+}
+auto request_set::operator[](size_t _index) const -> request *
+{
+    return _values[_index];
+}
+auto request_set::testall() -> bool
+{
+    //requests which are still waiting for their message cannot be tested yet
+    if (!refresh(false))
+        return false;
+
+    //test
+    auto _flag = int{};
+    MPI_Testall(_values.size(), _requests.data(), &_flag, _statuses.data());
+    if (_flag != true)
+        return false;
+
+    //write back requests and statuses
+    for (auto i = size_t{0}; i < _values.size(); ++i)
+        finish(i, _statuses[i]);
+    return true;
+}
+auto request_set::testany() -> size_t
+{
+    //requests which are still waiting for their message get a chance to be posted
+    refresh(false);
+
+    //test
+    auto _index = int{};
+    auto _flag = int{};
+    MPI_Testany(_values.size(), _requests.data(), &_index, &_flag, _statuses.data());
+    if (_flag != true || _index == MPI_UNDEFINED)
+        return npos;
+
+    //only the finished request has changed
+    finish(_index, _statuses.front());
+    return static_cast<size_t>(_index);
+}
+auto request_set::testsome() -> const std::vector<size_t> &
+{
+    //requests which are still waiting for their message get a chance to be posted
+    refresh(false);
+
+    //test
+    auto _count = 0;
+    MPI_Testsome(_values.size(), _requests.data(), &_count, _indexes.data(), _statuses.data());
+
+    //only the finished requests have changed
+    _completed.clear();
+    for (auto i = 0; i < _count && _count != MPI_UNDEFINED; ++i)
+    {
+        finish(_indexes[i], _statuses[i]);
+        _completed.push_back(static_cast<size_t>(_indexes[i]));
+    }
+    return _completed;
+}
+auto request_set::waitall() -> void
+{
+    //requests which are still waiting for their message need to be posted first
+    refresh(true);
+
+    //wait
+    MPI_Waitall(_values.size(), _requests.data(), _statuses.data());
+
+    //write back requests and statuses
+    for (auto i = size_t{0}; i < _values.size(); ++i)
+        finish(i, _statuses[i]);
+}
+auto request_set::waitany() -> size_t
+{
+    //as long as some requests are waiting for their message, we have to poll
+    while (!refresh(false))
+    {
+        auto _index = testany();
+        if (_index != npos)
+            return _index;
+    }
+
+    //wait
+    auto _index = int{};
+    MPI_Waitany(_values.size(), _requests.data(), &_index, _statuses.data());
+    if (_index == MPI_UNDEFINED)
+        return npos;
+
+    //only the finished request has changed
+    finish(_index, _statuses.front());
+    return static_cast<size_t>(_index);
+}
+auto request_set::waitsome() -> const std::vector<size_t> &
+{
+    //as long as some requests are waiting for their message, we have to poll
+    while (!refresh(false))
+    {
+        testsome();
+        if (!_completed.empty())
+            return _completed;
+    }
+
+    //wait
+    auto _count = 0;
+    MPI_Waitsome(_values.size(), _requests.data(), &_count, _indexes.data(), _statuses.data());
+
+    //only the finished requests have changed
+    _completed.clear();
+    for (auto i = 0; i < _count && _count != MPI_UNDEFINED; ++i)
+    {
+        finish(_indexes[i], _statuses[i]);
+        _completed.push_back(static_cast<size_t>(_indexes[i]));
+    }
+    return _completed;
+}
+#pragma endregion
 #pragma region sender_receiver
+//handles are passed around by value, so they have to stay cheap to copy
+static_assert(std::is_trivially_copyable<sender_receiver>::value, "sender_receiver has to be trivially copyable");
+static_assert(std::is_trivially_copyable<receiver>::value, "receiver has to be trivially copyable");
+static_assert(std::is_trivially_copyable<sender>::value, "sender has to be trivially copyable");
 sender_receiver::sender_receiver(int _dest, int _source, int _sendtag, int _recvtag, MPI_Comm _comm) : _dest(_dest), _source(_source), _sendtag(_sendtag), _recvtag(_recvtag), _comm(_comm)
 {
 }
@@ -1214,6 +2372,10 @@ auto sender_receiver::operator!=(const sender_receiver &rhs) -> bool
 {
     return !(*this == rhs);
 }
+auto sender_receiver::operator->() -> sender_receiver *
+{
+    return this;
+}
 
 auto sender_receiver::sendrecv_replace(std::string &_value) -> void
 {
@@ -1233,12 +2395,14 @@ auto receiver::operator!=(const receiver &rhs) -> bool
 {
     return !(*this == rhs);
 }
+auto receiver::operator->() -> receiver *
+{
+    return this;
+}
 
-auto receiver::dest(int _dest) -> std::unique_ptr<sender_receiver>
+auto receiver::dest(int _dest, int _tag) -> sender_receiver
 {
-    auto _sendtag = 0;
-    auto _recvtag = 0;
-    return std::make_unique<sender_receiver>(_dest, _source, _sendtag, _recvtag, _comm);
+    return sender_receiver{_dest, _source, _tag, this->_tag, _comm};
 }
 
 auto receiver::scatter(const char *_value, std::string &_bucket, const size_t _chunk_size) -> void
@@ -1289,12 +2453,14 @@ auto sender::operator!=(const sender &rhs) -> bool
 {
     return !(*this == rhs);
 }
+auto sender::operator->() -> sender *
+{
+    return this;
+}
 
-auto sender::source(int _source) -> std::unique_ptr<sender_receiver>
+auto sender::source(int _source, int _tag) -> sender_receiver
 {
-    auto _sendtag = 0;
-    auto _recvtag = 0;
-    return std::make_unique<sender_receiver>(_dest, _source, _sendtag, _recvtag, _comm);
+    return sender_receiver{_dest, _source, this->_tag, _tag, _comm};
 }
 
 auto sender::send(const char _value) -> void
@@ -1346,6 +2512,10 @@ auto sender::isend(const std::string &_value) -> std::unique_ptr<isend_request<s
 {
     return std::make_unique<isend_request<std::string>>(_dest, _tag, _comm, _value);
 }
+auto sender::isend(std::string &&_value) -> std::unique_ptr<isend_request<std::string>>
+{
+    return std::make_unique<isend_request<std::string>>(_dest, _tag, _comm, std::move(_value));
+}
 auto sender::issend(const char _value) -> std::unique_ptr<issend_request<std::string>>
 {
     return issend(std::string{_value});
@@ -1358,6 +2528,10 @@ auto sender::issend(const std::string &_value) -> std::unique_ptr<issend_request
 {
     return std::make_unique<issend_request<std::string>>(_dest, _tag, _comm, _value);
 }
+auto sender::issend(std::string &&_value) -> std::unique_ptr<issend_request<std::string>>
+{
+    return std::make_unique<issend_request<std::string>>(_dest, _tag, _comm, std::move(_value));
+}
 auto sender::irsend(const char _value) -> std::unique_ptr<irsend_request<std::string>>
 {
     return irsend(std::string{_value});
@@ -1370,6 +2544,10 @@ auto sender::irsend(const std::string &_value) -> std::unique_ptr<irsend_request
 {
     return std::make_unique<irsend_request<std::string>>(_dest, _tag, _comm, _value);
 }
+auto sender::irsend(std::string &&_value) -> std::unique_ptr<irsend_request<std::string>>
+{
+    return std::make_unique<irsend_request<std::string>>(_dest, _tag, _comm, std::move(_value));
+}
 
 auto sender::gather(const char _value, std::string &_bucket) -> void
 {